@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   accel.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:05:41 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 13:05:41 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef ACCEL_H
+# define ACCEL_H
+
+# include "spatial.h"
+# include <stddef.h>
+
+/*
+** Acceleration structure over the scene's bounded objects (planes
+** always keep their own loop). --accel or the M key picks one; the
+** others are built the first time they are selected. Group BVHs under
+** instances are BVHs whatever the top level uses.
+*/
+typedef enum e_accel_kind
+{
+	ACCEL_BVH,
+	ACCEL_GRID,
+	ACCEL_OCTREE,
+	ACCEL_NONE,
+	ACCEL_COUNT
+}	t_accel_kind;
+
+/*
+** Uniform grid: res[0] * res[1] * res[2] cells of size cell over
+** bounds, x fastest. Cell i holds refs[cells[i] .. cells[i + 1]); an
+** object is referenced by every cell its box overlaps.
+*/
+typedef struct s_grid
+{
+	t_aabb			bounds;
+	t_real			min[3];
+	t_real			cell[3];
+	t_real			inv_cell[3];
+	int				res[3];
+	int				*cells;
+	t_object_ref	*refs;
+	int				ref_count;
+	int				object_count;
+}	t_grid;
+
+/*
+** Sparse octree node. An inner node's eight children are stored
+** together from child on, octant bit 0 / 1 / 2 set for the upper
+** half in x / y / z. A leaf (child < 0) holds refs[offset ..+ count);
+** empty octants are leaves of count 0 and are never subdivided.
+*/
+typedef struct s_octree_node
+{
+	t_aabb	bounds;
+	int		child;
+	int		offset;
+	int		count;
+}	t_octree_node;
+
+typedef struct s_octree
+{
+	t_octree_node	*nodes;
+	int				node_count;
+	int				node_capacity;
+	t_object_ref	*refs;
+	int				ref_count;
+	int				ref_capacity;
+	int				object_count;
+	int				depth;
+	int				leaves;
+}	t_octree;
+
+/* Grid cells per object, and the cap on cells along one axis */
+# define GRID_DENSITY 3.0
+# define GRID_MAX_RES 256
+
+/* Octree leaves hold up to OCTREE_LEAF_SIZE objects unless too deep */
+# define OCTREE_LEAF_SIZE 4
+# define OCTREE_MAX_DEPTH 10
+# define OCTREE_STACK_SIZE (OCTREE_MAX_DEPTH * 7 + 8)
+
+/* Camera rays per axis traced by accel_probe */
+# define ACCEL_PROBE_W 64
+# define ACCEL_PROBE_H 36
+
+/*
+** Per-backend figures: build time, memory held by the structure and
+** the mean cost of one probe ray (a camera ray through the
+** accelerator, plus its shadow ray when it hits).
+*/
+typedef struct s_accel_stats
+{
+	double	build_ms;
+	size_t	bytes;
+	double	probe_us;
+	long	probe_rays;
+}	t_accel_stats;
+
+/*
+** One backend. build makes the structure if the scene has none yet
+** and fills its t_accel_stats; report prints its own summary line.
+** Both are NULL for "none", which has nothing to build.
+** intersect finds the closest hit below hit->distance and occluded
+** any hit closer than max_distance. Both need a prepared ray.
+*/
+typedef struct s_accel_ops
+{
+	const char	*name;
+	void		(*build)(t_scene *scene);
+	void		(*report)(t_scene *scene);
+	int			(*intersect)(t_scene *scene, t_ray *ray, t_hit *hit);
+	int			(*occluded)(t_scene *scene, t_ray *ray, t_real max_distance);
+}	t_accel_ops;
+
+/* Backend table and the queries trace_ray / is_in_shadow go through */
+const t_accel_ops	*accel_ops(int kind);
+int					accel_parse(const char *name);
+int					accel_intersect(t_scene *scene, t_ray *ray, t_hit *hit);
+int					accel_occluded(t_scene *scene, t_ray *ray,
+						t_real max_distance);
+int					accel_has_packets(t_scene *scene);
+
+/* Building, switching and keeping the active backend current */
+t_object_ref		*scene_object_refs(t_scene *scene, int *count);
+void				scene_build_accel(t_scene *scene);
+void				scene_select_accel(t_scene *scene, int kind);
+void				scene_update_accel(t_scene *scene);
+void				accel_mark_dirty(t_scene *scene, t_object_ref ref);
+void				accel_release(t_scene *scene);
+void				accel_probe(t_scene *scene);
+void				scene_report_accel(t_scene *scene);
+
+/* Build and report steps of the backend table */
+void				accel_build_bvh(t_scene *scene);
+void				accel_build_grid(t_scene *scene);
+void				accel_build_octree(t_scene *scene);
+void				accel_report_grid(t_scene *scene);
+void				accel_report_octree(t_scene *scene);
+
+/* Uniform grid with 3D-DDA traversal */
+t_grid				*grid_build(t_object_ref *refs, int count, t_scene *scene);
+void				grid_destroy(t_grid *grid);
+int					grid_intersect(t_grid *grid, t_scene *scene, t_ray *ray,
+						t_hit *hit);
+int					grid_occluded(t_grid *grid, t_scene *scene, t_ray *ray,
+						t_real max_distance);
+
+/* Sparse octree */
+t_octree			*octree_build(t_object_ref *refs, int count,
+						t_scene *scene);
+void				octree_destroy(t_octree *tree);
+int					octree_intersect(t_octree *tree, t_scene *scene,
+						t_ray *ray, t_hit *hit);
+int					octree_occluded(t_octree *tree, t_scene *scene,
+						t_ray *ray, t_real max_distance);
+
+#endif
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/08 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/08 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef BATCH_H
+# define BATCH_H
+
+# include <pthread.h>
+# include "minirt.h"
+# include "options.h"
+
+/*
+** One scene of a batch and out, the image it is written to
+** (batch_name_outputs). The loader thread fills scene, ok, the
+** parse/accelerator build timings and the BVH's SAH cost; the render
+** loop adds render/write timings and frees the scene once its image
+** is written.
+*/
+typedef struct s_batch_job
+{
+	char			*path;
+	char			*out;
+	t_scene			*scene;
+	int				ok;
+	double			parse_ms;
+	double			accel_ms;
+	double			bvh_cost;
+	double			render_ms;
+	double			write_ms;
+	int				accel;
+	t_bvh_config	bvh;
+}	t_batch_job;
+
+/* Ordered scene list plus the prefetch thread loading the next job */
+typedef struct s_batch
+{
+	t_batch_job		*jobs;
+	int				count;
+	int				capacity;
+	const char		*out_dir;
+	int				failures;
+	int				accel;
+	t_bvh_config	bvh;
+	pthread_t		loader;
+	int				loader_running;
+}	t_batch;
+
+/**
+ * @brief Render every scene of a batch offline in one process
+ *
+ * Worker threads and the framebuffer are created once and reused.
+ * While scene N renders, scene N+1 is parsed and its BVH built on a
+ * loader thread. One timing line is printed per scene.
+ *
+ * @param opts Options with batch_dir, scene_files and manifest
+ * @return Process exit status (0 if every scene rendered)
+ */
+int		batch_run(t_options *opts);
+
+/**
+ * @brief Collect jobs from the manifest (if any) then the scene files
+ * @return 1 on success, 0 on error (error already printed)
+ */
+int		batch_collect_jobs(t_batch *batch, t_options *opts);
+
+/**
+ * @brief Give every job its image path in the output directory
+ *
+ * Images are named after the scene file without ".rt"; when two
+ * scenes share a name the later ones get a "-2", "-3"... suffix.
+ *
+ * @return 1 on success, 0 on error (error already printed)
+ */
+int		batch_name_outputs(t_batch *batch);
+
+/**
+ * @brief Start loading job index on the loader thread
+ *
+ * Falls back to loading synchronously if the thread cannot start.
+ */
+void	batch_prefetch(t_batch *batch, int index);
+
+/**
+ * @brief Wait for the loader thread started by batch_prefetch
+ */
+void	batch_wait(t_batch *batch);
+
+/**
+ * @brief Free all jobs and any scenes still attached to them
+ */
+void	batch_cleanup(t_batch *batch);
+
+#endif
@@ -0,0 +1,409 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_wide.h                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/15 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/15 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Wide BVH body, compiled once per branching factor.
+** The including file defines:
+**   BVH_WIDTH           children per node (4 or 8)
+**   BVH_WIDE_BUILD      name of the exported collapse function
+**   BVH_WIDE_INTERSECT  name of the exported closest-hit function
+**   BVH_WIDE_OCCLUDED   name of the exported any-hit function
+**
+** The wide tree is collapsed from the flat binary one: each wide node
+** takes up to BVH_WIDTH of the binary nodes below it, always opening
+** the inner node with the largest box first. Child boxes are stored
+** per axis (SoA) so one vector sequence runs aabb_intersect's slab
+** test on a whole 256-bit group of children (4 doubles or 8 floats)
+** at once, with the same operations as the scalar test. Wider
+** vectors than the target registers are split by the compiler one
+** compare at a time, which is why groups never exceed 256 bits.
+*/
+
+#ifndef BVH_WIDE_H
+# define BVH_WIDE_H
+
+# include <stdlib.h>
+# include <string.h>
+# include "spatial.h"
+
+/* Children per slab test: BVH_WIDTH, at most 256 bits of t_real */
+# ifdef MINIRT_FLOAT
+#  define WIDE_GROUP 8
+# else
+#  define WIDE_GROUP 4
+# endif
+# if BVH_WIDTH < WIDE_GROUP
+#  undef WIDE_GROUP
+#  define WIDE_GROUP BVH_WIDTH
+# endif
+
+# define SIMD_LANES WIDE_GROUP
+# include "simd_real.h"
+
+/*
+** Worst-case stack: every visited node leaves BVH_WIDTH - 1 entries
+** behind, and the wide tree is no deeper than the binary one.
+*/
+# define BVH_WIDE_STACK ((BVH_MAX_DEPTH + 3) * BVH_WIDTH)
+
+/*
+** box[0] holds the children's min corners, box[1] the max corners.
+** count[i] > 0: child i is a leaf over prims[child[i] ..+ count[i]).
+** count[i] == 0: child i is the wide node child[i].
+** Lanes from n on are unused.
+*/
+typedef struct s_wide_node
+{
+	t_real	box[2][3][BVH_WIDTH];
+	int		child[BVH_WIDTH];
+	int		count[BVH_WIDTH];
+	int		n;
+}	t_wide_node;
+
+/* A child waiting on the stack and the distance its box is entered at */
+typedef struct s_wide_entry
+{
+	int		child;
+	int		count;
+	t_real	t;
+}	t_wide_entry;
+
+/*
+** One closest-hit query; org, inv and sign are the prepared ray's
+** origin, inverse direction and direction signs as arrays.
+*/
+typedef struct s_wide_walk
+{
+	t_bvh			*bvh;
+	t_wide_node		*nodes;
+	t_ray			ray;
+	t_real			org[3];
+	t_real			inv[3];
+	int				sign[3];
+	void			*scene;
+	t_wide_entry	stack[BVH_WIDE_STACK];
+	int				top;
+}	t_wide_walk;
+
+static t_real	wide_area(t_bvh *bvh, int index)
+{
+	return (aabb_surface_area(bvh_flat_bounds(&bvh->nodes[index])));
+}
+
+/*
+** Binary nodes that become the children of one wide node: start from
+** the node itself and keep opening the inner child with the largest
+** box until BVH_WIDTH children are reached or only leaves are left.
+*/
+static int	wide_gather(t_bvh *bvh, int index, int *kids)
+{
+	int	n;
+	int	i;
+	int	open;
+
+	kids[0] = index;
+	n = 1;
+	open = 0;
+	while (n < BVH_WIDTH && open >= 0)
+	{
+		open = -1;
+		i = -1;
+		while (++i < n)
+		{
+			if (bvh->nodes[kids[i]].count == 0 && (open < 0
+					|| wide_area(bvh, kids[i]) > wide_area(bvh, kids[open])))
+				open = i;
+		}
+		if (open >= 0)
+		{
+			kids[n++] = bvh->nodes[kids[open]].offset;
+			kids[open]++;
+		}
+	}
+	return (n);
+}
+
+static void	wide_set_lane(t_wide_node *node, int lane, t_bvh_flat_node *src)
+{
+	int	axis;
+
+	axis = -1;
+	while (++axis < 3)
+	{
+		node->box[0][axis][lane] = src->min[axis];
+		node->box[1][axis][lane] = src->max[axis];
+	}
+	node->child[lane] = src->offset;
+	node->count[lane] = src->count;
+}
+
+/* Emit the wide node covering binary node index; returns its slot */
+static int	wide_emit(t_bvh *bvh, t_wide_node *nodes, int *used, int index)
+{
+	int	kids[BVH_WIDTH];
+	int	slot;
+	int	lane;
+	int	child;
+
+	slot = (*used)++;
+	memset(&nodes[slot], 0, sizeof(t_wide_node));
+	nodes[slot].n = wide_gather(bvh, index, kids);
+	lane = -1;
+	while (++lane < nodes[slot].n)
+	{
+		wide_set_lane(&nodes[slot], lane, &bvh->nodes[kids[lane]]);
+		if (bvh->nodes[kids[lane]].count == 0)
+		{
+			child = wide_emit(bvh, nodes, used, kids[lane]);
+			nodes[slot].child[lane] = child;
+		}
+	}
+	return (slot);
+}
+
+/*
+** Collapse bvh->nodes into bvh->wide. A wide node always consumes at
+** least one binary inner node, so total_nodes slots are enough.
+*/
+int	BVH_WIDE_BUILD(t_bvh *bvh)
+{
+	t_wide_node	*nodes;
+	int			used;
+
+	nodes = malloc(sizeof(t_wide_node) * bvh->total_nodes);
+	if (!nodes)
+		return (0);
+	used = 0;
+	wide_emit(bvh, nodes, &used, 0);
+	bvh->wide = nodes;
+	bvh->wide_count = used;
+	bvh->wide_bytes = sizeof(t_wide_node) * bvh->total_nodes;
+	return (1);
+}
+
+static t_vreal	wide_load(const t_real *src)
+{
+	t_vreal	v;
+
+	memcpy(&v, src, sizeof(v));
+	return (v);
+}
+
+/*
+** aabb_intersect's three slabs for children [base, base + WIDE_GROUP):
+** range[0] = tmin, range[1] = tmax. The ray's sign picks the near and
+** far corners for all children at once.
+*/
+static void	wide_slabs(t_wide_walk *w, t_wide_node *node, int base,
+		t_vreal range[2])
+{
+	t_vreal	near;
+	t_vreal	far;
+	int		axis;
+
+	axis = -1;
+	while (++axis < 3)
+	{
+		near = (wide_load(node->box[w->sign[axis]][axis] + base)
+				- w->org[axis]) * w->inv[axis];
+		far = (wide_load(node->box[1 - w->sign[axis]][axis] + base)
+				- w->org[axis]) * w->inv[axis] * AABB_TMAX_SCALE;
+		range[0] = simd_select((t_vmask)(near > range[0]), near, range[0]);
+		range[1] = simd_select((t_vmask)(far < range[1]), far, range[1]);
+	}
+}
+
+/*
+** aabb_intersect on every child box over [RAY_T_MIN, closest].
+** entry receives the entry distances; returns a bit per child hit.
+*/
+static int	wide_boxes(t_wide_walk *w, t_wide_node *node, t_real closest,
+		t_real *entry)
+{
+	t_vreal	range[2];
+	t_vmask	hit;
+	int		base;
+	int		lane;
+	int		bits;
+
+	bits = 0;
+	base = 0;
+	while (base < node->n)
+	{
+		range[0] = simd_splat(RAY_T_MIN);
+		range[1] = simd_splat(1000000.0);
+		if (closest < 1000000.0)
+			range[1] = simd_splat(closest);
+		wide_slabs(w, node, base, range);
+		hit = (t_vmask)(range[1] >= range[0]) & (t_vmask)(range[1] > 0);
+		lane = -1;
+		while (++lane < WIDE_GROUP)
+		{
+			entry[base + lane] = range[0][lane];
+			if (hit[lane])
+				bits |= 1 << (base + lane);
+		}
+		base += WIDE_GROUP;
+	}
+	return (bits);
+}
+
+/*
+** Push the children whose boxes the ray enters before closest,
+** sorted so the nearest is popped first (ties in child order).
+*/
+static void	wide_push(t_wide_walk *w, t_wide_node *node, t_real closest)
+{
+	t_real	entry[BVH_WIDTH];
+	int		hit;
+	int		base;
+	int		lane;
+	int		i;
+
+	hit = wide_boxes(w, node, closest, entry);
+	base = w->top;
+	lane = node->n;
+	while (--lane >= 0)
+	{
+		if (hit & (1 << lane))
+		{
+			i = w->top++;
+			while (i > base && w->stack[i - 1].t < entry[lane])
+			{
+				w->stack[i] = w->stack[i - 1];
+				i--;
+			}
+			w->stack[i] = (t_wide_entry){node->child[lane],
+				node->count[lane], entry[lane]};
+		}
+	}
+}
+
+/* Leaf objects test straight into hit, like the binary ordered walk */
+static int	wide_leaf(t_wide_walk *w, t_wide_entry *e, t_hit_record *hit)
+{
+	int	i;
+	int	found;
+
+	found = 0;
+	i = e->child;
+	while (i < e->child + e->count)
+	{
+		if (bvh_intersect_object(w->bvh->prims[i], &w->ray, hit, w->scene))
+			found = 1;
+		i++;
+	}
+	return (found);
+}
+
+static void	wide_walk_init(t_wide_walk *w, t_bvh *bvh, t_ray *ray,
+		void *scene)
+{
+	w->bvh = bvh;
+	w->nodes = (t_wide_node *)bvh->wide;
+	w->ray = *ray;
+	w->org[0] = ray->origin.x;
+	w->org[1] = ray->origin.y;
+	w->org[2] = ray->origin.z;
+	w->inv[0] = ray->inv_dir.x;
+	w->inv[1] = ray->inv_dir.y;
+	w->inv[2] = ray->inv_dir.z;
+	w->sign[0] = ray->sign[0];
+	w->sign[1] = ray->sign[1];
+	w->sign[2] = ray->sign[2];
+	w->scene = scene;
+	w->top = 0;
+}
+
+/*
+** Closest hit through the wide tree. Popped entries whose box starts
+** beyond the closest hit found since they were pushed are dropped.
+*/
+int	BVH_WIDE_INTERSECT(t_bvh *bvh, t_ray ray, t_hit_record *hit, void *scene)
+{
+	t_wide_walk		w;
+	t_wide_entry	e;
+	int				found;
+
+	wide_walk_init(&w, bvh, &ray, scene);
+	wide_push(&w, &w.nodes[0], hit->distance);
+	found = 0;
+	while (w.top > 0)
+	{
+		e = w.stack[--w.top];
+		if (e.t <= hit->distance && e.count == 0)
+			wide_push(&w, &w.nodes[e.child], hit->distance);
+		else if (e.t <= hit->distance)
+			found |= wide_leaf(&w, &e, hit);
+	}
+	return (found);
+}
+
+/* Push every child whose box the ray enters before max_distance */
+static void	wide_push_any(t_wide_walk *w, t_wide_node *node,
+		t_real max_distance)
+{
+	t_real	entry[BVH_WIDTH];
+	int		hit;
+	int		lane;
+
+	hit = wide_boxes(w, node, max_distance, entry);
+	lane = node->n;
+	while (--lane >= 0)
+	{
+		if (hit & (1 << lane))
+			w->stack[w->top++] = (t_wide_entry){node->child[lane],
+				node->count[lane], entry[lane]};
+	}
+}
+
+/* 1 as soon as one of the leaf's objects blocks the ray */
+static int	wide_leaf_any(t_wide_walk *w, t_wide_entry *e,
+		t_real max_distance)
+{
+	int	i;
+
+	i = e->child;
+	while (i < e->child + e->count)
+	{
+		if (bvh_occlude_object(w->bvh->prims[i], &w->ray, max_distance,
+				w->scene))
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/*
+** Any-hit walk for shadow rays: children are pushed unsorted, since
+** the limit never shrinks, and the walk stops at the first occluder.
+*/
+int	BVH_WIDE_OCCLUDED(t_bvh *bvh, t_ray ray, t_real max_distance,
+		void *scene)
+{
+	t_wide_walk		w;
+	t_wide_entry	e;
+
+	wide_walk_init(&w, bvh, &ray, scene);
+	wide_push_any(&w, &w.nodes[0], max_distance);
+	while (w.top > 0)
+	{
+		e = w.stack[--w.top];
+		if (e.count == 0)
+			wide_push_any(&w, &w.nodes[e.child], max_distance);
+		else if (wide_leaf_any(&w, &e, max_distance))
+			return (1);
+	}
+	return (0);
+}
+
+#endif
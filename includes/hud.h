@@ -253,6 +253,11 @@ t_selection	hud_get_selection_from_global(int global_idx, t_scene *scene);
 */
 void	hud_format_float(char *buffer, double value);
 
+/*
+** Format integer to string. Buffer must be at least 12 bytes.
+*/
+void	hud_format_int(char *buffer, int value);
+
 /*
 ** Format vec3 to string "(x, y, z)" with 2 decimal places.
 ** Example: {1.5, 2.3, 3.7} -> "(1.50, 2.30, 3.70)"
@@ -278,15 +283,11 @@ void	hud_format_fps(char *buf, double fps);
 */
 void	hud_format_time_ms(char *buf, long time_us);
 
-/*
-** Format BVH enabled status to "ON" or "OFF".
-** Buffer must be at least 4 bytes.
-*/
-void	hud_format_bvh_status(char *buf, int enabled);
-
 /*
 ** Render performance metrics section in HUD.
-** Shows FPS, frame time, and BVH status.
+** Shows FPS, frame time, BVH status and, with a BVH, its quality
+** figures (t_bvh_stats): node/leaf counts, leaf depth, SAH cost,
+** sibling overlap and leaf sizes.
 ** Called internally by hud_render_content().
 */
 void	hud_render_performance(t_render *render, int *y);
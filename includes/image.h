@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image.h                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/07 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/07 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef IMAGE_H
+# define IMAGE_H
+
+# include <stddef.h>
+# include "window.h"
+# include "options.h"
+
+/**
+ * @brief Write the render framebuffer to an image file
+ *
+ * Format is chosen by extension: ".png" writes PNG, anything else
+ * writes binary PPM (P6).
+ *
+ * @param path Output file path
+ * @param render Render context holding the framebuffer
+ * @return 1 on success, 0 on error (error already printed)
+ */
+int			image_write(const char *path, t_render *render);
+
+/**
+ * @brief Write the framebuffer as binary PPM (P6)
+ * @return 1 on success, 0 on error
+ */
+int			image_write_ppm(const char *path, t_render *render);
+
+/**
+ * @brief Write the framebuffer as 8-bit RGB PNG (stored deflate blocks)
+ * @return 1 on success, 0 on error
+ */
+int			image_write_png(const char *path, t_render *render);
+
+/**
+ * @brief Convert framebuffer row y to packed 8-bit RGB triplets
+ * @param render Render context holding the framebuffer
+ * @param dst Destination, at least WINDOW_WIDTH * 3 bytes
+ * @param y Row index
+ */
+void		image_pack_row(t_render *render, unsigned char *dst, int y);
+
+/**
+ * @brief Write len bytes to path, replacing any existing file
+ * @return 1 on success, 0 on error
+ */
+int			image_write_file(const char *path, unsigned char *data,
+				size_t len);
+
+/**
+ * @brief Create a render context backed by a plain malloc'd framebuffer
+ *
+ * No MiniLibX connection is made, so this works without an X server.
+ *
+ * @param scene Scene to render
+ * @return Render context, or NULL on allocation failure
+ */
+t_render	*init_headless(t_scene *scene);
+
+/**
+ * @brief Render the scene once into a headless framebuffer and save it
+ * @param scene Parsed scene (BVH already built)
+ * @param opts Command line options (output path, thread count)
+ * @return Process exit status (0 on success)
+ */
+int			render_headless(t_scene *scene, t_options *opts);
+
+#endif
@@ -61,19 +61,64 @@ typedef struct s_light
 	t_color	color;
 }	t_light;
 
-/* Complete scene: ambient light, camera, light, and geometric objects */
+/* First allocation of each object array; it doubles whenever full */
+# define SCENE_INITIAL_CAPACITY 16
+
+/* Longest group name, terminating NUL included */
+# define GROUP_NAME_MAX 32
+
+/*
+** Named set of spheres, cylinders and meshes (gr lines) placed any
+** number of times by instances. The primitives are stored once, in
+** objects, a scene of their own that also owns the group's bottom-level
+** BVH; instances only add a transform and one reference in the scene
+** BVH, which acts as the top level.
+*/
+typedef struct s_group
+{
+	char			name[GROUP_NAME_MAX];
+	struct s_scene	*objects;
+}	t_group;
+
+/*
+** Complete scene: ambient light, camera, light, and geometric objects.
+** Object arrays are heap allocated and grow geometrically while the
+** scene is parsed (scene_reserve_*); *_capacity is their allocated
+** length and *_count the part in use. Meshes, groups and instances
+** follow the same scheme. Mesh triangles are only ever found in the
+** scene of a group, where the group's BVH covers them.
+*/
 typedef struct s_scene
 {
 	t_ambient		ambient;
 	t_camera		camera;
 	t_light			light;
 	t_shadow_config	shadow_config;
-	t_sphere		spheres[100];
+	t_sphere		*spheres;
 	int				sphere_count;
-	t_plane			planes[100];
+	int				sphere_capacity;
+	t_sphere_soa	sphere_soa;
+	t_plane			*planes;
 	int				plane_count;
-	t_cylinder		cylinders[100];
+	int				plane_capacity;
+	t_cylinder		*cylinders;
 	int				cylinder_count;
+	int				cylinder_capacity;
+	t_vertex		*vertices;
+	int				vertex_count;
+	int				vertex_capacity;
+	t_triangle		*triangles;
+	int				triangle_count;
+	int				triangle_capacity;
+	t_mesh			*meshes;
+	int				mesh_count;
+	int				mesh_capacity;
+	t_group			*groups;
+	int				group_count;
+	int				group_capacity;
+	t_instance		*instances;
+	int				instance_count;
+	int				instance_capacity;
 	int				has_ambient;
 	int				has_camera;
 	int				has_light;
@@ -88,8 +133,21 @@ int		ft_atoi(const char *str);
 /* Convert string to double */
 double	ft_atof(const char *str);
 
+/* Allocate a scene with default values (NULL on failure) */
+t_scene	*init_scene(void);
 /* Free allocated memory for scene structure */
 void	cleanup_scene(t_scene *scene);
+/* Make room for one more object of a kind; 0 if out of memory */
+int		scene_reserve_sphere(t_scene *scene);
+int		scene_reserve_plane(t_scene *scene);
+int		scene_reserve_cylinder(t_scene *scene);
+int		scene_reserve_vertex(t_scene *scene);
+int		scene_reserve_triangle(t_scene *scene);
+int		scene_reserve_mesh(t_scene *scene);
+int		scene_reserve_group(t_scene *scene);
+int		scene_reserve_instance(t_scene *scene);
+/* Free the object arrays of a scene */
+void	scene_free_objects(t_scene *scene);
 /* Free allocated memory for render structure */
 void	cleanup_render(void *render);
 /* Free all allocated memory (scene and render) */
@@ -108,9 +166,28 @@ t_color	apply_lighting(t_scene *scene, t_hit *hit);
 
 /* Test ray-sphere intersection and update hit info if closer */
 int		intersect_sphere(t_ray *ray, t_sphere *sphere, t_hit *hit);
+/* Copy sphere index into the SoA arrays after it is parsed or moved */
+void	scene_sync_sphere(t_scene *scene, int index);
+/* Closest hit among all spheres (SIMD); hit->distance is the limit */
+int		intersect_spheres(t_scene *scene, t_ray *ray, t_hit *hit);
+/* 1 if any sphere is hit within [RAY_T_MIN, max_distance] (SIMD) */
+int		spheres_occlude(t_scene *scene, t_ray *ray, t_real max_distance);
 /* Test ray-plane intersection and update hit info if closer */
 int		intersect_plane(t_ray *ray, t_plane *plane, t_hit *hit);
+/* Recompute plane index's offset d after it is parsed or moved */
+void	scene_sync_plane(t_scene *scene, int index);
+/* Closest hit among all planes; hit->distance is the limit */
+int		intersect_planes(t_scene *scene, t_ray *ray, t_hit *hit);
+/* 1 if any plane is hit within [RAY_T_MIN, max_distance] */
+int		planes_occlude(t_scene *scene, t_ray *ray, t_real max_distance);
 /* Test ray-cylinder intersection and update hit info if closer */
 int		intersect_cylinder(t_ray *ray, t_cylinder *cylinder, t_hit *hit);
+int		intersect_triangle(t_ray *ray, t_scene *scene, int index, t_hit *hit);
+/* 1 if triangle index is hit within [RAY_T_MIN, max_distance] */
+int		triangle_occludes(t_ray *ray, t_scene *scene, int index,
+			t_real max_distance);
+/* Brute force over every bounded object (the "none" accelerator) */
+int		objects_intersect(t_scene *scene, t_ray *ray, t_hit *hit);
+int		objects_occlude(t_scene *scene, t_ray *ray, t_real max_distance);
 
 #endif
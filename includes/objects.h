@@ -27,18 +27,39 @@ typedef struct s_color
 typedef struct s_sphere
 {
 	t_vec3	center;
-	double	diameter;
+	t_real	diameter;
 	t_color	color;
-	double	radius;
-	double	radius_squared;
+	t_real	radius;
+	t_real	radius_squared;
 }	t_sphere;
 
-/* Infinite plane defined by a point, normal vector, and color */
+/*
+** Hot sphere data as structure of arrays for the SIMD sphere kernel,
+** kept in sync with the parsed t_sphere array (scene_sync_sphere).
+** Only these fields are read while searching for the closest hit;
+** the t_sphere records (diameter, color) are read for the winner only.
+** The arrays hold sphere_capacity entries, always a whole number of
+** 8-lane blocks, so a SIMD load of the last block stays in bounds.
+*/
+typedef struct s_sphere_soa
+{
+	t_real	*cx;
+	t_real	*cy;
+	t_real	*cz;
+	t_real	*r2;
+}	t_sphere_soa;
+
+/*
+** Infinite plane defined by a point, normal vector, and color.
+** d = dot(normal, point) is cached for the plane equation
+** (scene_sync_plane).
+*/
 typedef struct s_plane
 {
 	t_vec3	point;
 	t_vec3	normal;
 	t_color	color;
+	t_real	d;
 }	t_plane;
 
 /* Finite cylinder defined by center, axis, diameter, height, and color */
@@ -46,12 +67,58 @@ typedef struct s_cylinder
 {
 	t_vec3	center;
 	t_vec3	axis;
-	double	diameter;
-	double	height;
+	t_real	diameter;
+	t_real	height;
 	t_color	color;
-	double	radius;
-	double	radius_squared;
-	double	half_height;
+	t_real	radius;
+	t_real	radius_squared;
+	t_real	half_height;
 }	t_cylinder;
 
+/*
+** Mesh vertex. Single precision keeps the vertex buffer compact; OBJ
+** exports carry no more precision than this anyway.
+*/
+typedef struct s_vertex
+{
+	float	x;
+	float	y;
+	float	z;
+}	t_vertex;
+
+/* Mesh triangle: indices into the scene's vertex buffer, and its mesh */
+typedef struct s_triangle
+{
+	int	v[3];
+	int	mesh;
+}	t_triangle;
+
+/* Triangle mesh loaded from an OBJ file (mh line) */
+typedef struct s_mesh
+{
+	t_color	color;
+	int		first_triangle;
+	int		triangle_count;
+	int		vertex_count;
+}	t_mesh;
+
+/*
+** One placement of a group (in line): a point p of the group lands at
+** position + scale * (axis[0] * p.x + axis[1] * p.y + axis[2] * p.z).
+** axis holds the group's local x, y and z axes after rotation, so it
+** is orthonormal and its transpose takes rays back into group space.
+** box_min and box_max are its world bounds, set once the group's BVH
+** exists (scene_build_groups) so the scene BVH builders read them for
+** free.
+*/
+typedef struct s_instance
+{
+	int		group;
+	t_vec3	position;
+	t_vec3	axis[3];
+	t_real	scale;
+	t_vec3	box_min;
+	t_vec3	box_max;
+}	t_instance;
+
 #endif
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/05 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/05 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef OPTIONS_H
+# define OPTIONS_H
+
+# include "spatial.h"
+# include "accel.h"
+
+/*
+** Command line options; thread_count 0 means one thread per CPU.
+** output_file set means render once offline and exit (no window).
+** batch_dir set means render every scene in scene_files (and the
+** manifest, if any) offline into that directory.
+** simd picks the primary-ray packet kernel (t_simd_mode), accel the
+** acceleration structure (t_accel_kind) and bvh the BVH split
+** strategy, closest-hit walk and build threads (t_bvh_config).
+*/
+typedef struct s_options
+{
+	const char		*scene_file;
+	const char		**scene_files;
+	int				scene_count;
+	const char		*output_file;
+	const char		*batch_dir;
+	const char		*manifest;
+	int				thread_count;
+	int				simd;
+	int				accel;
+	t_bvh_config	bvh;
+}	t_options;
+
+/**
+ * @brief Parse command line arguments into options
+ * @param argc Argument count from main
+ * @param argv Argument vector from main
+ * @param opts Options structure to populate
+ * @return 1 on success, 0 on error (error already printed)
+ */
+int		parse_options(int argc, char **argv, t_options *opts);
+
+/**
+ * @brief Free the scene file list built by parse_options
+ *
+ * scene_file stays valid afterwards (it points into argv).
+ */
+void	options_cleanup(t_options *opts);
+
+/**
+ * @brief Print command line usage to stdout
+ * @param program Program name (argv[0])
+ */
+void	print_usage(const char *program);
+
+#endif
@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet.h                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PACKET_H
+# define PACKET_H
+
+/*
+** SIMD packet tracing of primary rays.
+**
+** A packet is a block of neighbouring pixels traced together: 2x2
+** (4 lanes, SSE-width kernel) or 4x2 (8 lanes, AVX2 kernel). All lanes
+** share the camera origin, walk the BVH once with a per-lane active
+** mask and test objects with vectorized sphere/plane/cylinder code.
+** The tests repeat the scalar arithmetic step by step, so the image
+** is identical to the scalar path. Shading stays per pixel.
+*/
+
+typedef struct s_render	t_render;
+typedef struct s_tile	t_tile;
+
+/* Kernel selection for --simd */
+typedef enum e_simd_mode
+{
+	SIMD_AUTO,
+	SIMD_OFF,
+	SIMD_SSE,
+	SIMD_AVX2
+}	t_simd_mode;
+
+/* Renders a full-quality tile with packets; returns rays traced */
+typedef long	(*t_packet_fn)(t_render *render, t_tile *tile);
+
+/**
+ * @brief Pick the packet kernel for this CPU
+ *
+ * SIMD_AUTO uses the 8-lane AVX2 kernel when the CPU supports it and
+ * the 4-lane kernel otherwise. SIMD_AVX2 falls back to 4 lanes with a
+ * warning on CPUs without AVX2.
+ *
+ * @param mode Requested mode
+ * @return Kernel, or NULL for the scalar path (SIMD_OFF)
+ */
+t_packet_fn	packet_select_kernel(t_simd_mode mode);
+
+/**
+ * @brief 1 if the CPU runs AVX2 code (always 0 off x86)
+ *
+ * Gates every kernel compiled with -mavx2: the 8-lane packets and
+ * the wide BVH walks.
+ */
+int			cpu_has_avx2(void);
+
+/**
+ * @brief Human readable kernel name for logs
+ */
+const char	*packet_kernel_name(t_packet_fn kernel);
+
+/* 2x2 kernel, baseline SIMD (SSE2 on x86-64, NEON on arm64) */
+long		render_tile_packet4(t_render *render, t_tile *tile);
+/* 4x2 kernel, compiled with -mavx2 on x86-64 */
+long		render_tile_packet8(t_render *render, t_tile *tile);
+
+#endif
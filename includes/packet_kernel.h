@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet_kernel.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Packet tracer body, compiled once per lane width.
+** The including file defines:
+**   PACKET_LANES  lanes per packet (4 or 8)
+**   PACKET_W      packet width in pixels (rows = PACKET_LANES / PACKET_W)
+**   PACKET_ENTRY  name of the exported tile function
+** Lanes use GCC vector extensions, so the compiler emits whatever SIMD
+** the translation unit is built for (SSE2, AVX2 or NEON).
+**
+** Every vector expression repeats the scalar code in src/ray and
+** src/spatial operation for operation (same operand order, no fused
+** multiply-add), which keeps packet and scalar images bit-identical.
+*/
+
+#ifndef PACKET_KERNEL_H
+# define PACKET_KERNEL_H
+
+# include <math.h>
+# include "minirt.h"
+# include "window.h"
+# include "spatial.h"
+# include "packet.h"
+
+# define SIMD_LANES PACKET_LANES
+# include "simd_real.h"
+
+# define PACKET_ROWS (PACKET_LANES / PACKET_W)
+
+/*
+** Rays of one packet: shared origin, per-lane directions (SoA),
+** closest distance and object found so far. mask holds the lanes
+** taking part in the current leaf; da is the per-cylinder d . axis.
+** ix, iy and iz are the inverse directions for the slab tests.
+*/
+typedef struct s_packet
+{
+	t_vreal		dx;
+	t_vreal		dy;
+	t_vreal		dz;
+	t_vreal		ix;
+	t_vreal		iy;
+	t_vreal		iz;
+	t_vreal		dd;
+	t_vreal		best;
+	t_vreal		da;
+	t_vmask		active;
+	t_vmask		mask;
+	t_vec3		origin;
+	t_scene		*scene;
+	int			type[PACKET_LANES];
+	int			index[PACKET_LANES];
+}	t_packet;
+
+/* Normalized primary directions of PACKET_ROWS rows of a tile */
+typedef struct s_packet_rows
+{
+	t_render	*render;
+	t_tile		*tile;
+	int			y;
+	int			count;
+	t_vec3		dir[PACKET_ROWS][RENDER_TILE_SIZE];
+}	t_packet_rows;
+
+/* vec3_dot(v, direction) for every lane */
+static t_vreal	pk_dot_dir(t_packet *p, t_vec3 v)
+{
+	return (p->dx * v.x + p->dy * v.y + p->dz * v.z);
+}
+
+/*
+** Keep t for lanes in mask where the scalar test would accept it
+** (not below RAY_T_MIN, not beyond the current closest hit).
+*/
+static void	pk_accept(t_packet *p, t_vreal t, t_vmask mask, t_object_ref ref)
+{
+	int	i;
+
+	mask &= ~(t_vmask)(t < RAY_T_MIN) & ~(t_vmask)(t > p->best);
+	p->best = simd_select(mask, t, p->best);
+	i = 0;
+	while (i < PACKET_LANES)
+	{
+		if (mask[i])
+		{
+			p->type[i] = ref.type;
+			p->index[i] = ref.index;
+		}
+		i++;
+	}
+}
+
+#endif
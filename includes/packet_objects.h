@@ -0,0 +1,273 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet_objects.h                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Vectorized object tests and BVH walk of the packet tracer.
+** Part of the packet kernel template: include after packet_kernel.h.
+*/
+
+#ifndef PACKET_OBJECTS_H
+# define PACKET_OBJECTS_H
+
+/* intersect_sphere / calculate_sphere_t */
+static void	pk_sphere(t_packet *p, t_sphere *sphere, t_object_ref ref)
+{
+	t_vec3	oc;
+	t_vreal	half_b;
+	t_vreal	proj;
+	t_vreal	l2;
+
+	oc = vec3_subtract(p->origin, sphere->center);
+	half_b = pk_dot_dir(p, oc);
+	proj = half_b / p->dd;
+	l2 = simd_len2(oc.x - p->dx * proj, oc.y - p->dy * proj,
+			oc.z - p->dz * proj);
+	pk_accept(p, simd_nearest_root(p->dd, half_b,
+			simd_splat(vec3_dot(oc, oc) - sphere->radius_squared),
+			p->dd * (sphere->radius_squared - l2)), p->mask, ref);
+}
+
+/* intersect_plane */
+static void	pk_plane(t_packet *p, t_plane *plane, t_object_ref ref)
+{
+	t_vreal	denom;
+	t_real	num;
+
+	denom = pk_dot_dir(p, plane->normal);
+	num = plane->d - vec3_dot(plane->normal, p->origin);
+	pk_accept(p, num / denom,
+		p->mask & ~(t_vmask)(simd_fabs(denom) < REAL_EPSILON), ref);
+}
+
+/* calculate_cylinder_intersection; -1 marks lanes with no root */
+static t_vreal	pk_cylinder_root(t_packet *p, t_cylinder *cyl, t_vec3 oc,
+		t_real oa)
+{
+	t_vreal	a;
+	t_vreal	half_b;
+	t_vreal	disc;
+	t_real	c;
+
+	a = p->dd - p->da * p->da;
+	half_b = pk_dot_dir(p, oc) - p->da * oa;
+	c = vec3_dot(oc, oc) - oa * oa - cyl->radius_squared;
+	disc = half_b * half_b - a * c;
+	return (simd_select(~(t_vmask)(disc < 0)
+			& ~(t_vmask)(a < REAL_EPSILON),
+			simd_nearest_root(a, half_b, simd_splat(c), disc), simd_splat(-1)));
+}
+
+/* intersect_cylinder_cap */
+static void	pk_cylinder_cap(t_packet *p, t_cylinder *cyl, t_object_ref ref,
+		t_real cap_m)
+{
+	t_vec3	center;
+	t_vreal	t;
+	t_vmask	mask;
+
+	center = vec3_add(cyl->center, vec3_multiply(cyl->axis, cap_m));
+	mask = p->mask & ~(t_vmask)(simd_fabs(p->da) < REAL_EPSILON);
+	t = vec3_dot(vec3_subtract(center, p->origin), cyl->axis) / p->da;
+	mask &= ~(t_vmask)(simd_len2(p->origin.x + p->dx * t - center.x,
+				p->origin.y + p->dy * t - center.y,
+				p->origin.z + p->dz * t - center.z) > cyl->radius_squared);
+	pk_accept(p, t, mask, ref);
+}
+
+/* intersect_cylinder: body, then top and bottom caps */
+static void	pk_cylinder(t_packet *p, t_cylinder *cyl, t_object_ref ref)
+{
+	t_vec3	oc;
+	t_real	oa;
+	t_vreal	t;
+	t_vreal	m;
+
+	p->da = pk_dot_dir(p, cyl->axis);
+	oc = vec3_subtract(p->origin, cyl->center);
+	oa = vec3_dot(oc, cyl->axis);
+	t = pk_cylinder_root(p, cyl, oc, oa);
+	m = p->da * t + oa;
+	pk_accept(p, t, p->mask & ~(t_vmask)(m < -cyl->half_height)
+		& ~(t_vmask)(m > cyl->half_height), ref);
+	pk_cylinder_cap(p, cyl, ref, cyl->half_height);
+	pk_cylinder_cap(p, cyl, ref, -cyl->half_height);
+}
+
+/*
+** instance_intersect, one lane at a time: the lanes' rays diverge in
+** group space, so the group's BVH is walked with the scalar code.
+*/
+static void	pk_instance(t_packet *p, t_object_ref ref)
+{
+	t_ray	ray;
+	t_hit	hit;
+	int		i;
+
+	ray.origin = p->origin;
+	i = 0;
+	while (i < PACKET_LANES)
+	{
+		ray.direction = (t_vec3){p->dx[i], p->dy[i], p->dz[i]};
+		hit.distance = p->best[i];
+		if (p->mask[i] && instance_intersect(p->scene,
+				&p->scene->instances[ref.index], &ray, &hit))
+		{
+			p->best[i] = hit.distance;
+			p->type[i] = ref.type;
+			p->index[i] = ref.index;
+		}
+		i++;
+	}
+}
+
+static void	pk_object(t_packet *p, t_object_ref ref)
+{
+	if (ref.type == OBJ_SPHERE)
+		pk_sphere(p, &p->scene->spheres[ref.index], ref);
+	else if (ref.type == OBJ_PLANE)
+		pk_plane(p, &p->scene->planes[ref.index], ref);
+	else if (ref.type == OBJ_CYLINDER)
+		pk_cylinder(p, &p->scene->cylinders[ref.index], ref);
+	else if (ref.type == OBJ_INSTANCE)
+		pk_instance(p, ref);
+}
+
+/*
+** One slab of aabb_intersect: range[0] = tmin, range[1] = tmax.
+** Lanes differ in direction sign, so near and far are picked with a
+** select; NaN distances leave the range alone as in the scalar test.
+*/
+static void	pk_slab(t_real lo, t_real hi, t_vreal inv, t_vreal range[2])
+{
+	t_vreal	t0;
+	t_vreal	t1;
+	t_vmask	swap;
+	t_vreal	near;
+
+	t0 = lo * inv;
+	t1 = hi * inv;
+	swap = (t_vmask)(inv < 0);
+	near = simd_select(swap, t1, t0);
+	t1 = simd_select(swap, t0, t1) * AABB_TMAX_SCALE;
+	range[0] = simd_select((t_vmask)(near > range[0]), near, range[0]);
+	range[1] = simd_select((t_vmask)(t1 < range[1]), t1, range[1]);
+}
+
+/* Lanes whose ray hits box: aabb_intersect over [RAY_T_MIN, t_max] */
+static t_vmask	pk_box(t_packet *p, t_aabb *box, t_vreal t_max)
+{
+	t_vreal	range[2];
+
+	range[0] = simd_splat(RAY_T_MIN);
+	range[1] = t_max;
+	pk_slab(box->min.x - p->origin.x, box->max.x - p->origin.x, p->ix, range);
+	pk_slab(box->min.y - p->origin.y, box->max.y - p->origin.y, p->iy, range);
+	pk_slab(box->min.z - p->origin.z, box->max.z - p->origin.z, p->iz, range);
+	return ((t_vmask)(range[1] >= range[0]) & (t_vmask)(range[1] > 0));
+}
+
+static void	pk_node(t_packet *p, t_bvh *bvh, int index, t_vmask mask);
+
+/*
+** Children of an inner node. The ordered walk takes the nearer child
+** first for lane 0's direction (the packet's rays are nearly parallel)
+** so the far child is clipped by the hits found in the near one.
+*/
+static void	pk_children(t_packet *p, t_bvh *bvh, int index, t_vmask mask)
+{
+	t_bvh_flat_node	*node;
+	t_real			dir;
+
+	node = &bvh->nodes[index];
+	dir = p->dz[0];
+	if (node->axis == 0)
+		dir = p->dx[0];
+	else if (node->axis == 1)
+		dir = p->dy[0];
+	if (bvh->config.traversal == BVH_TRAVERSAL_ORDERED && dir < 0)
+	{
+		pk_node(p, bvh, node->offset, mask);
+		pk_node(p, bvh, index + 1, mask);
+		return ;
+	}
+	pk_node(p, bvh, index + 1, mask);
+	pk_node(p, bvh, node->offset, mask);
+}
+
+/*
+** Shared BVH walk: a node is visited once for the whole packet with
+** the lanes whose rays hit its box; it is skipped when none do.
+** The ordered walk clips each lane's box test to its closest hit.
+*/
+static void	pk_node(t_packet *p, t_bvh *bvh, int index, t_vmask mask)
+{
+	t_bvh_flat_node	*node;
+	t_aabb			bounds;
+	t_vreal			t_max;
+	int				i;
+
+	node = &bvh->nodes[index];
+	bounds = bvh_flat_bounds(node);
+	t_max = simd_splat(1000000.0);
+	if (bvh->config.traversal == BVH_TRAVERSAL_ORDERED)
+		t_max = simd_select((t_vmask)(p->best < t_max), p->best, t_max);
+	mask &= pk_box(p, &bounds, t_max);
+	if (!simd_any(mask))
+		return ;
+	if (node->count == 0)
+	{
+		pk_children(p, bvh, index, mask);
+		return ;
+	}
+	i = 0;
+	while (i < (int)node->count)
+	{
+		p->mask = mask;
+		pk_object(p, bvh->prims[node->offset + i]);
+		i++;
+	}
+}
+
+/* intersect_planes: planes are not in the BVH, so both walks use it */
+static void	pk_planes(t_packet *p)
+{
+	t_object_ref	ref;
+
+	p->mask = p->active;
+	ref.type = OBJ_PLANE;
+	ref.index = -1;
+	while (++ref.index < p->scene->plane_count)
+		pk_object(p, ref);
+}
+
+/* Brute force over every object, in trace_ray's order */
+static void	pk_all_objects(t_packet *p)
+{
+	t_object_ref	ref;
+
+	p->mask = p->active;
+	ref.type = OBJ_SPHERE;
+	ref.index = -1;
+	while (++ref.index < p->scene->sphere_count)
+		pk_object(p, ref);
+	ref.type = OBJ_CYLINDER;
+	ref.index = -1;
+	while (++ref.index < p->scene->cylinder_count)
+		pk_object(p, ref);
+	ref.type = OBJ_INSTANCE;
+	ref.index = -1;
+	while (++ref.index < p->scene->instance_count)
+		pk_object(p, ref);
+	pk_planes(p);
+}
+
+#endif
@@ -0,0 +1,184 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet_trace.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Tile loop of the packet tracer: loads packets, finds the closest
+** object per lane and shades each pixel with the scalar code.
+** Part of the packet kernel template: include after packet_objects.h.
+*/
+
+#ifndef PACKET_TRACE_H
+# define PACKET_TRACE_H
+
+t_color	trace_ray(t_scene *scene, t_ray *ray);
+
+/*
+** Directions of the next PACKET_ROWS rows, accumulated exactly like
+** render_row so every pixel gets the same direction as the scalar path.
+*/
+static void	pk_rows_init(t_packet_rows *rows)
+{
+	t_camera_frame	*cam;
+	t_vec3			dir;
+	int				x;
+
+	cam = &rows->render->camera;
+	rows->count = 0;
+	while (rows->count < PACKET_ROWS
+		&& rows->y + rows->count < rows->tile->y + rows->tile->h)
+	{
+		dir = vec3_add(vec3_add(cam->corner, vec3_multiply(cam->dy,
+						rows->y + rows->count)),
+				vec3_multiply(cam->dx, rows->tile->x));
+		x = 0;
+		while (x < rows->tile->w)
+		{
+			rows->dir[rows->count][x++] = vec3_normalize(dir);
+			dir = vec3_add(dir, cam->dx);
+		}
+		rows->count++;
+	}
+}
+
+/*
+** Lane i covers pixel (x + i % PACKET_W, row i / PACKET_W). Lanes past
+** the tile edge are inactive and reuse lane 0's direction.
+*/
+static void	pk_load(t_packet *p, t_packet_rows *rows, int x)
+{
+	t_vec3	d;
+	int		i;
+	int		row;
+	int		col;
+
+	i = -1;
+	while (++i < PACKET_LANES)
+	{
+		row = i / PACKET_W;
+		col = x + i % PACKET_W;
+		p->active[i] = 0;
+		d = rows->dir[0][x];
+		if (row < rows->count && col < rows->tile->w)
+		{
+			p->active[i] = -1;
+			d = rows->dir[row][col];
+		}
+		p->dx[i] = d.x;
+		p->dy[i] = d.y;
+		p->dz[i] = d.z;
+		p->type[i] = OBJ_NONE;
+	}
+	p->dd = simd_len2(p->dx, p->dy, p->dz);
+	p->ix = 1 / p->dx;
+	p->iy = 1 / p->dy;
+	p->iz = 1 / p->dz;
+}
+
+/*
+** Rebuild the full hit record of a lane's closest object with the
+** scalar test, then light it like trace_ray does.
+*/
+static t_color	pk_shade(t_packet *p, int lane)
+{
+	t_ray	ray;
+	t_hit	hit;
+	int		found;
+	int		index;
+
+	ray.origin = p->origin;
+	ray.direction = (t_vec3){p->dx[lane], p->dy[lane], p->dz[lane]};
+	if (p->type[lane] == OBJ_NONE)
+		return ((t_color){0, 0, 0});
+	hit.distance = REAL_MAX;
+	index = p->index[lane];
+	found = 0;
+	if (p->type[lane] == OBJ_SPHERE)
+		found = intersect_sphere(&ray, &p->scene->spheres[index], &hit);
+	else if (p->type[lane] == OBJ_PLANE)
+		found = intersect_plane(&ray, &p->scene->planes[index], &hit);
+	else if (p->type[lane] == OBJ_CYLINDER)
+		found = intersect_cylinder(&ray, &p->scene->cylinders[index], &hit);
+	else if (p->type[lane] == OBJ_INSTANCE)
+		found = instance_intersect(p->scene, &p->scene->instances[index],
+				&ray, &hit);
+	if (!found)
+		return (trace_ray(p->scene, &ray));
+	return (apply_lighting(p->scene, &hit));
+}
+
+/*
+** Trace one packet at tile column x and write its pixels.
+** Mirrors trace_ray: BVH plus the plane loop with the BVH backend
+** (starting from REAL_MAX), all objects from INFINITY with "none".
+** Other backends never get here (accel_has_packets).
+** Returns the number of rays traced.
+*/
+static long	pk_trace(t_packet *p, t_packet_rows *rows, int x)
+{
+	t_bvh	*bvh;
+	int		i;
+	long	rays;
+
+	pk_load(p, rows, x);
+	bvh = p->scene->render_state.bvh;
+	p->best = simd_splat(INFINITY);
+	if (p->scene->render_state.accel == ACCEL_BVH && bvh)
+	{
+		p->best = simd_splat(REAL_MAX);
+		if (bvh->nodes && bvh->enabled)
+			pk_node(p, bvh, 0, p->active);
+		pk_planes(p);
+	}
+	else
+		pk_all_objects(p);
+	rays = 0;
+	i = -1;
+	while (++i < PACKET_LANES)
+	{
+		if (p->active[i])
+		{
+			put_pixel_to_buffer(rows->render, rows->tile->x + x + i % PACKET_W,
+				rows->y + i / PACKET_W, pk_shade(p, i));
+			rays++;
+		}
+	}
+	return (rays);
+}
+
+long	PACKET_ENTRY(t_render *render, t_tile *tile)
+{
+	t_packet_rows	rows;
+	t_packet		packet;
+	int				x;
+	long			rays;
+
+	rows.render = render;
+	rows.tile = tile;
+	packet.origin = render->camera.origin;
+	packet.scene = render->scene;
+	rays = 0;
+	rows.y = tile->y;
+	while (rows.y < tile->y + tile->h)
+	{
+		pk_rows_init(&rows);
+		x = 0;
+		while (x < tile->w)
+		{
+			rays += pk_trace(&packet, &rows, x);
+			x += PACKET_W;
+		}
+		rows.y += PACKET_ROWS;
+	}
+	return (rays);
+}
+
+#endif
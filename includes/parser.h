@@ -15,6 +15,35 @@
 
 # include "minirt.h"
 
+/* OBJ files are read OBJ_READ_SIZE bytes at a time */
+# define OBJ_READ_SIZE 65536
+
+/*
+** Longest OBJ line, terminating NUL included; longer lines are skipped,
+** or an error when they hold a vertex or a face
+*/
+# define OBJ_LINE_MAX 1024
+
+/* Longest mesh file path, terminating NUL included */
+# define MESH_PATH_MAX 1024
+
+/*
+** State of one OBJ load: the read buffer (len bytes, pos consumed),
+** the current line, and where the file's vertices start in the
+** scene's vertex buffer (OBJ indices count from 1 within the file).
+*/
+typedef struct s_obj_reader
+{
+	int		fd;
+	int		len;
+	int		pos;
+	char	buf[OBJ_READ_SIZE];
+	char	line[OBJ_LINE_MAX];
+	t_scene	*scene;
+	int		first_vertex;
+	int		mesh;
+}	t_obj_reader;
+
 /**
  * @brief Parse scene file and populate scene structure
  * @param filename Path to .rt file
@@ -71,6 +100,51 @@ int		parse_plane(char *line, t_scene *scene);
  */
 int		parse_cylinder(char *line, t_scene *scene);
 
+/**
+ * @brief Parse one member of a named group (gr line)
+ * @param line Line to parse
+ * @param scene Scene structure
+ * @param scene_file Path of the scene file, for relative mesh paths
+ * @return 1 on success, 0 on error
+ */
+int		parse_group(char *line, t_scene *scene, const char *scene_file);
+
+/**
+ * @brief Parse an instance of a group (in line)
+ * @param line Line to parse
+ * @param scene Scene structure
+ * @return 1 on success, 0 on error
+ */
+int		parse_instance(char *line, t_scene *scene);
+
+/**
+ * @brief Parse a mesh outside any group (mh line)
+ * @param line Line to parse
+ * @param scene Scene structure
+ * @return 1 on success, 0 on error
+ */
+int		parse_placed_mesh(char *line, t_scene *scene,
+			const char *scene_file);
+
+/**
+ * @brief Parse a mesh into scene (mh <file.obj> <R,G,B>)
+ * @param line Line to parse, starting at "mh"
+ * @param scene Scene receiving the vertices and triangles
+ * @param scene_file Path of the scene file; relative OBJ paths are
+ *        resolved against its directory
+ * @return 1 on success, 0 on error
+ */
+int		parse_mesh(char *line, t_scene *scene, const char *scene_file);
+
+/**
+ * @brief Stream the vertices and faces of an OBJ file into scene
+ * @param path OBJ file path
+ * @param scene Scene receiving the vertices and triangles
+ * @param mesh Index of the mesh the triangles belong to
+ * @return 1 on success, 0 on error
+ */
+int		obj_load(const char *path, t_scene *scene, int mesh);
+
 /**
  * @brief Validate scene has required elements
  * @param scene Scene structure to validate
@@ -94,6 +168,13 @@ int		parse_vector(char *str, t_vec3 *vec);
  */
 int		parse_color(char *str, t_color *color);
 
+/**
+ * @brief Skip the current token and the spaces after it
+ * @param token Start of the current token
+ * @return Start of the next token
+ */
+char	*skip_to_next_token(char *token);
+
 /**
  * @brief Check if value is in range [min, max]
  * @param value Value to check
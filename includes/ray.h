@@ -17,18 +17,30 @@
 # include "objects.h"
 # include <stdbool.h>
 
-/* Ray with origin point and normalized direction vector */
+/*
+** Ray with origin point and normalized direction vector.
+** inv_dir (1 / direction, +-inf for zero components) and sign
+** (1 where inv_dir is negative) are set by ray_prepare for the
+** branch-free slab tests; only BVH walks read them. ray_prepare also
+** sets up the watertight triangle test: k is the axis permutation
+** that makes direction[k[2]] the largest component and shear the
+** transform taking the direction onto +z.
+*/
 typedef struct s_ray
 {
 	t_vec3	origin;
 	t_vec3	direction;
+	t_vec3	inv_dir;
+	int		sign[3];
+	int		k[3];
+	t_vec3	shear;
 }	t_ray;
 
 /* Ray-object intersection result with hit point and surface info */
 typedef struct s_hit
 {
 	bool	hit;
-	double	distance;
+	t_real	distance;
 	t_vec3	point;
 	t_vec3	normal;
 	t_color	color;
@@ -40,11 +52,18 @@ typedef t_hit	t_hit_record;
 typedef int	(*t_intersect_fn)(t_ray *ray, void *object, t_hit *hit);
 
 /* Function declarations */
+void	ray_prepare(t_ray *ray);
 int		intersect_sphere(t_ray *ray, t_sphere *sphere, t_hit *hit);
+void	sphere_set_hit(t_ray *ray, t_sphere *sphere, t_real t, t_hit *hit);
 int		intersect_plane(t_ray *ray, t_plane *plane, t_hit *hit);
+void	plane_set_hit(t_ray *ray, t_plane *plane, t_real t, t_hit *hit);
 int		intersect_cylinder(t_ray *ray, t_cylinder *cylinder, t_hit *hit);
 int		intersect_cylinder_body(t_ray *ray, t_cylinder *cyl, t_hit *hit);
 int		intersect_cylinder_cap(t_ray *ray, t_cylinder *cyl, t_hit *hit, \
-		double cap_m);
+		t_real cap_m);
+int		sphere_occludes(t_ray *ray, t_sphere *sphere, t_real max_distance);
+int		cylinder_occludes(t_ray *ray, t_cylinder *cyl, t_real max_distance);
+t_real	quadratic_nearest_root(t_real a, t_real half_b, t_real c,
+			t_real discriminant);
 
 #endif
@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   real.h                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/09 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/09 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef REAL_H
+# define REAL_H
+
+# include <math.h>
+# include <float.h>
+
+/*
+** Scalar type of the geometry pipeline: vectors, objects, hit
+** distances and bounding boxes. Double by default; building with
+** -DMINIRT_FLOAT (make FLOAT=1) switches everything to float.
+** t_real_bits is the same-width integer, used for SIMD lane masks.
+**
+** Epsilons follow the precision:
+**   RAY_T_MIN        smallest accepted hit distance. Float hit points
+**                    carry ~1e-4 absolute error at scene scale, so the
+**                    self-intersection guard is wider.
+**   REAL_EPSILON     near-zero guard for parallel ray tests.
+**   AABB_TMAX_SCALE  1 + 2 * gamma(3): widens the slab exit distance so
+**                    rounding in the slab test never culls a box the
+**                    ray actually touches.
+*/
+# ifdef MINIRT_FLOAT
+
+typedef float	t_real;
+typedef int		t_real_bits;
+
+#  define REAL_SQRT sqrtf
+#  define REAL_FABS fabsf
+#  define REAL_COPYSIGN copysignf
+#  define REAL_MAX FLT_MAX
+#  define RAY_T_MIN 4e-3f
+#  define REAL_EPSILON 1e-4f
+#  define AABB_TMAX_SCALE 1.0000004f
+
+# else
+
+typedef double		t_real;
+typedef long long	t_real_bits;
+
+#  define REAL_SQRT sqrt
+#  define REAL_FABS fabs
+#  define REAL_COPYSIGN copysign
+#  define REAL_MAX DBL_MAX
+#  define RAY_T_MIN 1e-3
+#  define REAL_EPSILON 1e-4
+#  define AABB_TMAX_SCALE 1.0000000000000007
+
+# endif
+
+#endif
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_pool.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/05 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/05 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef RENDER_POOL_H
+# define RENDER_POOL_H
+
+# include <pthread.h>
+
+/* Forward declarations */
+typedef struct s_scene			t_scene;
+typedef struct s_render			t_render;
+typedef struct s_render_pool	t_render_pool;
+
+/* Edge length in pixels of the square tiles handed to render workers */
+# define RENDER_TILE_SIZE 32
+
+/* Upper bound on render threads accepted from the command line */
+# define RENDER_MAX_THREADS 256
+
+/* Rectangular framebuffer region rendered as one unit of work */
+typedef struct s_tile
+{
+	int	x;
+	int	y;
+	int	w;
+	int	h;
+}	t_tile;
+
+/* Per-worker tile deque: owner pops from the tail, thieves from the head */
+typedef struct s_tile_deque
+{
+	t_tile			*tiles;
+	int				head;
+	int				tail;
+	pthread_mutex_t	lock;
+}	t_tile_deque;
+
+/* Render worker: one thread and the deque of tiles it owns */
+typedef struct s_render_worker
+{
+	pthread_t		thread;
+	int				id;
+	int				started;
+	t_render_pool	*pool;
+	t_tile_deque	deque;
+	long			rays;
+}	t_render_worker;
+
+/*
+** Persistent pool of render workers reused for every frame.
+** Worker 0 is the calling thread, so thread_count 1 spawns nothing.
+*/
+typedef struct s_render_pool
+{
+	t_render_worker	*workers;
+	int				thread_count;
+	t_tile			*frame_tiles;
+	int				frame_tile_count;
+	t_render		*render;
+	pthread_mutex_t	lock;
+	pthread_cond_t	wake;
+	pthread_cond_t	done;
+	long			generation;
+	int				busy;
+	int				shutdown;
+}	t_render_pool;
+
+/* Tile deque operations (no locking needed while workers are idle) */
+int				deque_init(t_tile_deque *dq, int capacity);
+void			deque_destroy(t_tile_deque *dq);
+void			deque_push(t_tile_deque *dq, t_tile tile);
+int				deque_pop(t_tile_deque *dq, t_tile *tile);
+int				deque_steal(t_tile_deque *dq, t_tile *tile);
+
+/* Pool lifecycle; thread_count 0 selects one thread per online CPU */
+t_render_pool	*render_pool_create(int thread_count);
+void			render_pool_destroy(t_render_pool *pool);
+int				render_default_thread_count(void);
+int				render_build_tiles(t_tile *tiles, int width, int height,
+					int tile_size);
+
+/* Render tiles across all workers; blocks until every tile is done */
+long			render_pool_run(t_render_pool *pool, t_render *render,
+					t_tile *tiles, int count);
+
+/* Trace every pixel of one tile into the image buffer; returns rays */
+long			render_tile(t_render *render, t_tile *tile);
+
+#endif
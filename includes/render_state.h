@@ -15,6 +15,7 @@
 
 # include "metrics.h"
 # include "spatial.h"
+# include "accel.h"
 # include <sys/time.h>
 
 /* Quality mode for adaptive rendering */
@@ -32,7 +33,14 @@ typedef struct s_interaction_state
 	int				interaction_count;
 }	t_interaction_state;
 
-/* Progressive rendering state */
+/* Per-tick time budget for progressive rendering (~60 Hz) */
+# define PROGRESSIVE_BUDGET_US 16000
+
+/*
+** Progressive rendering state.
+** order lists tile indices center-out; a pass is in progress while
+** current_tile < total_tiles.
+*/
 typedef struct s_progressive_state
 {
 	int		enabled;
@@ -40,9 +48,18 @@ typedef struct s_progressive_state
 	int		total_tiles;
 	int		tiles_completed;
 	int		tile_size;
+	int		tiles_x;
+	int		*order;
 }	t_progressive_state;
 
-/* Complete render state management */
+/*
+** Complete render state management.
+** bvh_cache is the BVH cache file of the scene (--bvh-cache), owned
+** by the state, or NULL when caching is off. accel is the active
+** t_accel_kind; bvh, grid and octree are whichever backends have been
+** built so far, and accel_stale marks grid and octree out of date
+** after an object moved.
+*/
 typedef struct s_render_state
 {
 	t_quality_mode			quality;
@@ -51,8 +68,14 @@ typedef struct s_render_state
 	t_progressive_state		progressive;
 	t_metrics				metrics;
 	t_bvh					*bvh;
+	t_grid					*grid;
+	t_octree				*octree;
 	int						adaptive_enabled;
-	int						bvh_enabled;
+	int						accel;
+	int						accel_stale;
+	t_accel_stats			accel_stats[ACCEL_COUNT];
+	t_bvh_config			bvh_config;
+	char					*bvh_cache;
 	int						show_info;
 }	t_render_state;
 
@@ -67,10 +90,11 @@ int		quality_should_upgrade(t_render_state *state);
 void	quality_handle_interaction(t_render_state *state);
 
 /* Progressive rendering */
-void	progressive_init(t_progressive_state *prog, int width, int height,
+int		progressive_init(t_progressive_state *prog, int width, int height,
 			int tile_size);
 int		progressive_next_tile(t_progressive_state *prog, int *x, int *y,
 			int *w, int *h);
 void	progressive_reset(t_progressive_state *prog);
+void	progressive_cleanup(t_progressive_state *prog);
 
 #endif
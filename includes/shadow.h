@@ -18,6 +18,12 @@
 /* Forward declaration */
 typedef struct s_scene	t_scene;
 
+/* Upper bound on shadow samples, the size of the sample table */
+# define SHADOW_MAX_SAMPLES 256
+
+/* Disk rotations the shading points are spread over */
+# define SHADOW_ROTATIONS 64
+
 /**
  * @brief Shadow configuration structure
  * 
@@ -26,6 +32,10 @@ typedef struct s_scene	t_scene;
  * softness: Shadow edge softness factor (0.0-1.0)
  * bias_scale: Shadow bias multiplier to prevent shadow acne
  * enable_ao: Enable ambient occlusion (not implemented yet)
+ * probes: Leading samples cast first to detect the penumbra
+ * disk: Sample offsets on the light disk (Sobol points, scaled by
+ *       softness), rebuilt whenever samples or softness change
+ * rotation: cos / sin of the per-point disk rotations
  */
 typedef struct s_shadow_config
 {
@@ -33,6 +43,9 @@ typedef struct s_shadow_config
 	double	softness;
 	double	bias_scale;
 	int		enable_ao;
+	int		probes;
+	double	disk[SHADOW_MAX_SAMPLES][2];
+	double	rotation[SHADOW_ROTATIONS][2];
 }	t_shadow_config;
 
 /**
@@ -54,7 +67,7 @@ int				validate_shadow_config(t_shadow_config *config);
  * @brief Set number of shadow samples
  * 
  * @param config Shadow configuration
- * @param samples Number of samples (min 1)
+ * @param samples Number of samples (1 to SHADOW_MAX_SAMPLES)
  */
 void			set_shadow_samples(t_shadow_config *config, int samples);
 
@@ -81,23 +94,40 @@ double			calculate_shadow_bias(t_vec3 normal, t_vec3 light_dir, \
 				double base_bias);
 
 /**
- * @brief Generate shadow sample offset
+ * @brief Build the shadow sample tables of a configuration
  * 
- * Creates a random offset for shadow ray sampling to produce soft shadows.
- * Uses stratified sampling for better distribution.
+ * Fills disk with the first samples points of the 2D Sobol sequence,
+ * mapped onto a disk of radius softness * 2 (concentric mapping), the
+ * outermost point of each sector first as probes, and the rotation
+ * table. Called again by the setters whenever samples or softness
+ * change, so the shadow loop itself needs no trigonometry.
  * 
- * @param radius Sampling radius
- * @param sample_index Current sample index
- * @param total_samples Total number of samples
- * @return Offset vector
+ * @param config Shadow configuration
+ */
+void			shadow_build_table(t_shadow_config *config);
+
+/**
+ * @brief Disk axes for the shadow samples of one point
+ * 
+ * Two axes spanning the plane perpendicular to light_dir, turned by
+ * the rotation picked for point (Cranley-Patterson rotation) so
+ * neighbouring pixels sample the light with decorrelated patterns.
+ * Sample i lies at light + disk[i][0] * axes[0] + disk[i][1] * axes[1].
+ * 
+ * @param config Shadow configuration
+ * @param point Shaded point
+ * @param light_dir Unit direction from point to the light
+ * @param axes Receives the two axes
  */
-t_vec3			generate_shadow_sample_offset(double radius, \
-				int sample_index, int total_samples);
+void			shadow_sample_axes(const t_shadow_config *config, \
+				t_vec3 point, t_vec3 light_dir, t_vec3 axes[2]);
 
 /**
  * @brief Calculate shadow factor using multiple shadow rays
  * 
  * Casts multiple shadow rays to determine shadow intensity.
+ * A few probe rays go first; the full sample count is only spent
+ * when they disagree (in the penumbra).
  * Returns 0.0 for no shadow, 1.0 for full shadow.
  * 
  * @param scene Scene data
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   simd_real.h                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Vector math on t_real lanes with GCC vector extensions, shared by
+** the SIMD kernels. The including file defines SIMD_LANES first; the
+** helpers are static, so each translation unit gets its own width
+** and whatever instruction set it is compiled for.
+*/
+
+#ifndef SIMD_REAL_H
+# define SIMD_REAL_H
+
+# include "real.h"
+
+typedef t_real		t_vreal __attribute__((vector_size(SIMD_LANES
+				* sizeof(t_real))));
+typedef t_real_bits	t_vmask __attribute__((vector_size(SIMD_LANES
+				* sizeof(t_real))));
+
+static inline t_vreal	simd_splat(t_real value)
+{
+	t_vreal	v;
+	int		i;
+
+	i = 0;
+	while (i < SIMD_LANES)
+		v[i++] = value;
+	return (v);
+}
+
+static inline t_vreal	simd_select(t_vmask mask, t_vreal a, t_vreal b)
+{
+	return ((t_vreal)(((t_vmask)a & mask) | ((t_vmask)b & ~mask)));
+}
+
+static inline int	simd_any(t_vmask mask)
+{
+	int	i;
+
+	i = 0;
+	while (i < SIMD_LANES)
+	{
+		if (mask[i])
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/* Lane-wise sqrt; IEEE sqrt is exact, so it matches REAL_SQRT */
+static inline t_vreal	simd_sqrt(t_vreal x)
+{
+	int	i;
+
+	i = 0;
+	while (i < SIMD_LANES)
+	{
+		x[i] = REAL_SQRT(x[i]);
+		i++;
+	}
+	return (x);
+}
+
+static inline t_vreal	simd_copysign(t_vreal mag, t_vreal sign)
+{
+	t_vmask	bit;
+
+	bit = (t_vmask)simd_splat(-0.0);
+	return ((t_vreal)(((t_vmask)mag & ~bit) | ((t_vmask)sign & bit)));
+}
+
+static inline t_vreal	simd_fabs(t_vreal x)
+{
+	return ((t_vreal)((t_vmask)x & ~(t_vmask)simd_splat(-0.0)));
+}
+
+static inline t_vreal	simd_len2(t_vreal x, t_vreal y, t_vreal z)
+{
+	return (x * x + y * y + z * z);
+}
+
+/* Vector form of quadratic_nearest_root; -1 marks lanes with no root */
+static inline t_vreal	simd_nearest_root(t_vreal a, t_vreal half_b,
+		t_vreal c, t_vreal disc)
+{
+	t_vmask	valid;
+	t_vmask	swap;
+	t_vreal	q;
+	t_vreal	t0;
+	t_vreal	t1;
+
+	valid = ~(t_vmask)(disc < 0);
+	q = -half_b - simd_copysign(simd_sqrt(disc), half_b);
+	valid &= ~(t_vmask)(q == 0);
+	t0 = c / q;
+	t1 = q / a;
+	swap = (t_vmask)(t0 > t1);
+	q = simd_select(swap, t1, t0);
+	t1 = simd_select(swap, t0, t1);
+	q = simd_select((t_vmask)(q < RAY_T_MIN), t1, q);
+	return (simd_select(valid, q, simd_splat(-1)));
+}
+
+#endif
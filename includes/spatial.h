@@ -16,6 +16,8 @@
 # include "vec3.h"
 # include "ray.h"
 # include "objects.h"
+# include <stddef.h>
+# include <stdint.h>
 
 /* Forward declarations */
 typedef struct s_scene	t_scene;
@@ -34,7 +36,11 @@ typedef struct s_object_ref
 	int	index;
 }	t_object_ref;
 
-/* BVH tree node for spatial acceleration */
+/*
+** BVH tree node as produced by the builders. The tree only exists
+** during bvh_build; it is flattened into t_bvh_flat_node for traversal.
+** axis is the split axis of an inner node.
+*/
 typedef struct s_bvh_node
 {
 	t_aabb				bounds;
@@ -42,46 +48,305 @@ typedef struct s_bvh_node
 	struct s_bvh_node	*right;
 	t_object_ref		*objects;
 	int					object_count;
+	int					axis;
 }	t_bvh_node;
 
-/* BVH tree root structure */
+/*
+** Flattened BVH node, 32 bytes (two per cache line). Nodes are stored
+** in depth-first order: an inner node's left child is the next node
+** and offset is the index of its right child. A leaf (count > 0)
+** covers prims[offset .. offset + count). Bounds are single precision,
+** rounded outward so the box always contains the double-precision one.
+*/
+typedef struct s_bvh_flat_node
+{
+	float			min[3];
+	float			max[3];
+	int				offset;
+	unsigned int	count : 30;
+	unsigned int	axis : 2;
+}	t_bvh_flat_node;
+
+/* Split strategy used by bvh_build */
+typedef enum e_bvh_builder
+{
+	BVH_BUILDER_SAH,
+	BVH_BUILDER_MIDPOINT
+}	t_bvh_builder;
+
+/* Closest-hit walk used by bvh_intersect */
+typedef enum e_bvh_traversal
+{
+	BVH_TRAVERSAL_ORDERED,
+	BVH_TRAVERSAL_RECURSIVE
+}	t_bvh_traversal;
+
+/*
+** Command line BVH choices: t_bvh_builder, t_bvh_traversal, the
+** branching factor of the ordered walk (2, or 4 / 8 for a wide BVH),
+** the number of build threads (0 = one per CPU), whether the built
+** tree is cached next to the scene file (--bvh-cache) and whether its
+** statistics are dumped after the build (--bvh-stats).
+*/
+typedef struct s_bvh_config
+{
+	int	builder;
+	int	traversal;
+	int	width;
+	int	threads;
+	int	cache;
+	int	stats;
+}	t_bvh_config;
+
+/*
+** One subtree for the builders to split: objects[0 .. count) at
+** depth. While forks > 0, bvh_build_children hands the left child to
+** a thread of its own and builds the right one itself; every level
+** down has one fork fewer.
+*/
+typedef struct s_bvh_task
+{
+	t_object_ref	*objects;
+	int				count;
+	void			*scene;
+	int				depth;
+	int				forks;
+	int				builder;
+}	t_bvh_task;
+
+/* Branching factor of the ordered walk unless --bvh-width says otherwise */
+# define BVH_DEFAULT_WIDTH 2
+
+/*
+** Parallel build: subtrees smaller than BVH_FORK_MIN_OBJECTS are not
+** worth a thread, and at most BVH_MAX_FORKS levels are forked.
+*/
+# define BVH_FORK_MIN_OBJECTS 1024
+# define BVH_MAX_FORKS 6
+
+/*
+** Depth limit shared by both builders, only a guard: the SAH builder
+** already stops when no split pays off, and scenes whose objects span
+** many scales (clusters within clusters) need well over 20 levels
+** before every leaf is small. Leaves sit at most one level below it.
+*/
+# define BVH_MAX_DEPTH 48
+
+/*
+** Nodes waiting on the binary walks' stacks. Each visited inner node
+** replaces itself with its two children, so a stack never holds more
+** than depth + 1 entries, at most BVH_MAX_DEPTH + 2.
+*/
+# define BVH_STACK_SIZE 64
+
+/* ref.type values (t_obj_type) the object -> slot index covers */
+# define BVH_REF_TYPES 6
+
+/* SAH cost of visiting one inner node, in units of one object test */
+# define BVH_TRAVERSAL_COST 1.0
+
+/*
+** Refit keeps the topology and only grows boxes; once the refitted
+** tree's SAH sum exceeds BVH_REFIT_MAX_GROWTH times the sum it had
+** when built, scene_update_bvh rebuilds it instead. The sums are
+** compared rather than the costs, which divide by the current root
+** area and so hide the degradation of objects moving outward.
+*/
+# define BVH_REFIT_MAX_GROWTH 1.5
+
+/*
+** Histogram sizes of t_bvh_stats; the last bin takes everything above.
+** The depth histogram has a bin for every leaf depth a build can give.
+*/
+# define BVH_STATS_DEPTHS (BVH_MAX_DEPTH + 2)
+# define BVH_STATS_LEAF_BINS 8
+
+/*
+** Tree quality figures from bvh_compute_stats. depth_hist counts
+** leaves per depth and leaf_hist leaves per object count (bin i holds
+** leaves of i + 1 objects). overlap sums the volume shared by the two
+** children of every inner node; overlap_ratio is that sum over the
+** root's volume.
+*/
+typedef struct s_bvh_stats
+{
+	int		nodes;
+	int		leaves;
+	int		min_depth;
+	int		max_depth;
+	double	avg_depth;
+	int		depth_hist[BVH_STATS_DEPTHS];
+	int		leaf_hist[BVH_STATS_LEAF_BINS];
+	t_real	sah_cost;
+	double	overlap;
+	double	overlap_ratio;
+}	t_bvh_stats;
+
+/*
+** BVH: node array (total_nodes entries, root at index 0) and the
+** object references of all leaves, reordered so each leaf's objects
+** are contiguous. prim_leaf holds the leaf of each prims entry, slot
+** the prims entry of each object (bvh_object_slot), and dirty flags
+** the leaves whose objects moved since the last refit (dirty_count of
+** them). build_cost is the SAH cost right after the last build and
+** build_ms the time it took; sah_sum is the current cost before the
+** division by the root's area, which bvh_refit keeps up to date, and
+** build_sum its value at the last build or load.
+** wide is the 4- or 8-wide tree collapsed from nodes (wide_count
+** nodes used of the wide_bytes allocated) when config.width asks for
+** one. stats describes the current tree (bvh_compute_stats). When the
+** tree came from the on-disk cache (cached set), nodes and prims point
+** into the map_size bytes mapped at map rather than into their own
+** allocations.
+*/
 typedef struct s_bvh
 {
-	t_bvh_node	*root;
-	int			enabled;
-	int			total_nodes;
-	int			max_depth;
+	t_bvh_flat_node	*nodes;
+	t_object_ref	*prims;
+	int				*prim_leaf;
+	int				*slot;
+	int				slot_base[BVH_REF_TYPES + 1];
+	unsigned char	*dirty;
+	int				dirty_count;
+	t_real			build_cost;
+	double			sah_sum;
+	double			build_sum;
+	double			build_ms;
+	void			*wide;
+	int				wide_count;
+	size_t			wide_bytes;
+	void			*map;
+	size_t			map_size;
+	int				cached;
+	int				enabled;
+	int				total_nodes;
+	int				prim_count;
+	int				max_depth;
+	t_bvh_stats		stats;
+	t_bvh_config	config;
 }	t_bvh;
 
+/*
+** On-disk BVH cache (--bvh-cache): this header, then the flat node
+** array and the reordered object references exactly as they sit in
+** memory, so loading is a single mmap. The mapping is private; refits
+** write to copy-on-write pages and never reach the file.
+*/
+# define BVH_CACHE_MAGIC "miniRTbv"
+# define BVH_CACHE_VERSION 2
+
+typedef struct s_bvh_cache_header
+{
+	char		magic[8];
+	uint64_t	hash;
+	int32_t		version;
+	int32_t		total_nodes;
+	int32_t		prim_count;
+	int32_t		max_depth;
+	double		build_cost;
+	char		reserved[24];
+}	t_bvh_cache_header;
+
 /* AABB operations */
 t_aabb		aabb_create(t_vec3 min, t_vec3 max);
 t_aabb		aabb_merge(t_aabb a, t_aabb b);
-t_aabb		aabb_for_sphere(t_vec3 center, double radius);
-t_aabb		aabb_for_cylinder(t_vec3 center, t_vec3 axis, double radius,
-				double height);
+t_aabb		aabb_for_sphere(t_vec3 center, t_real radius);
+t_aabb		aabb_for_cylinder(t_vec3 center, t_vec3 axis, t_real radius,
+				t_real height);
 t_aabb		aabb_for_plane(t_vec3 point, t_vec3 normal);
-int			aabb_intersect(t_aabb box, t_ray ray, double *t_min, double *t_max);
-double		aabb_surface_area(t_aabb box);
+int			aabb_intersect(const t_aabb *box, const t_ray *ray, t_real *t_min,
+				t_real *t_max);
+t_real		aabb_surface_area(t_aabb box);
 
 /* BVH construction */
 t_bvh		*bvh_create(void);
 void		bvh_destroy(t_bvh *bvh);
 void		bvh_build(t_bvh *bvh, t_object_ref *objects, int count,
 				void *scene);
-t_bvh_node	*bvh_build_recursive(t_object_ref *objects, int count,
-				void *scene, int depth);
+t_bvh_node	*bvh_build_recursive(t_bvh_task *task);
+t_bvh_node	*bvh_build_sah(t_bvh_task *task);
+t_bvh_node	*bvh_build_subtree(t_bvh_task *task);
+void		bvh_build_children(t_bvh_node *node, t_bvh_task *task, int mid);
+int			bvh_build_threads(int threads);
+t_aabb		bvh_compute_bounds(t_object_ref *objects, int count,
+				void *scene);
+t_bvh_node	*bvh_create_leaf(t_object_ref *objects, int count, void *scene);
+int			bvh_flatten(t_bvh *bvh, t_bvh_node *root);
+int			bvh_clear_arrays(t_bvh *bvh);
+t_aabb		bvh_flat_bounds(const t_bvh_flat_node *node);
+void		bvh_flat_store_bounds(t_bvh_flat_node *node, t_aabb box);
+
+/* Wide BVH, collapsed from the binary one */
+int			bvh_wide_build(t_bvh *bvh);
+void		bvh_wide_clear(t_bvh *bvh);
+int			bvh_wide4_build(t_bvh *bvh);
+int			bvh_wide8_build(t_bvh *bvh);
+int			bvh_wide4_intersect(t_bvh *bvh, t_ray ray, t_hit_record *hit,
+				void *scene);
+int			bvh_wide8_intersect(t_bvh *bvh, t_ray ray, t_hit_record *hit,
+				void *scene);
+int			bvh_wide4_occluded(t_bvh *bvh, t_ray ray, t_real max_distance,
+				void *scene);
+int			bvh_wide8_occluded(t_bvh *bvh, t_ray ray, t_real max_distance,
+				void *scene);
+
+/* On-disk BVH cache ("<scene>.bvh") */
+char		*bvh_cache_path(const char *scene_file);
+uint64_t	bvh_scene_hash(t_object_ref *refs, int count, void *scene,
+				int builder);
+int			bvh_cache_load(t_bvh *bvh, const char *path, uint64_t hash,
+				t_scene *scene);
+void		bvh_cache_save(t_bvh *bvh, const char *path, uint64_t hash);
+void		bvh_cache_unmap(t_bvh *bvh);
+
+/* BVH refit after objects move */
+int			bvh_index_slots(t_bvh *bvh);
+int			bvh_object_slot(const t_bvh *bvh, t_object_ref ref);
+void		bvh_mark_dirty(t_bvh *bvh, t_object_ref ref);
+int			bvh_refit(t_bvh *bvh, void *scene);
+double		bvh_sah_sum(const t_bvh *bvh);
+t_real		bvh_sah_per_root(const t_bvh *bvh, double sum);
+t_real		bvh_sah_cost(t_bvh *bvh);
+
+/* BVH quality report */
+void		bvh_compute_stats(t_bvh *bvh);
+double		bvh_node_overlap(const t_bvh *bvh, int index);
+void		bvh_stats_update_costs(t_bvh *bvh);
+void		bvh_print_stats(const t_bvh *bvh);
+size_t		bvh_memory_bytes(const t_bvh *bvh);
 
 /* BVH traversal */
 int			bvh_intersect(t_bvh *bvh, t_ray ray, t_hit_record *hit,
 				void *scene);
-int			bvh_node_intersect(t_bvh_node *node, t_ray ray, t_hit_record *hit,
+int			bvh_intersect_object(t_object_ref ref, t_ray *ray,
+				t_hit_record *hit, void *scene);
+
+/* BVH occlusion (any-hit) queries for shadow rays */
+int			bvh_occluded(t_bvh *bvh, t_ray ray, t_real max_distance,
 				void *scene);
+int			bvh_occlude_object(t_object_ref ref, t_ray *ray,
+				t_real max_distance, void *scene);
 
 /* Object bounds calculation */
 t_aabb		get_object_bounds(t_object_ref ref, void *scene);
 t_vec3		get_object_center(t_object_ref ref, void *scene);
 
+/*
+** Instancing: the scene BVH is the top level, its OBJ_INSTANCE leaves
+** lead into the bottom-level BVH of each group.
+*/
+void		scene_update_instances(t_scene *scene);
+int			instance_intersect(t_scene *scene, const t_instance *instance,
+				t_ray *ray, t_hit *hit);
+int			instance_occludes(t_scene *scene, const t_instance *instance,
+				t_ray *ray, t_real max_distance);
+void		scene_build_groups(t_scene *scene);
+void		scene_report_instances(t_scene *scene);
+size_t		scene_group_bytes(t_scene *scene);
+
 /* Scene BVH initialization */
 void		scene_build_bvh(t_scene *scene);
+void		scene_update_bvh(t_scene *scene);
+void		scene_report_bvh(t_scene *scene);
 
 #endif
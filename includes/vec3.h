@@ -13,12 +13,14 @@
 #ifndef VEC3_H
 # define VEC3_H
 
+# include "real.h"
+
 /* 3D vector or point in space with x, y, z coordinates */
 typedef struct s_vec3
 {
-	double	x;
-	double	y;
-	double	z;
+	t_real	x;
+	t_real	y;
+	t_real	z;
 }	t_vec3;
 
 /* Add two vectors component-wise */
@@ -26,13 +28,13 @@ t_vec3	vec3_add(t_vec3 a, t_vec3 b);
 /* Subtract vector b from vector a component-wise */
 t_vec3	vec3_subtract(t_vec3 a, t_vec3 b);
 /* Multiply vector by scalar value */
-t_vec3	vec3_multiply(t_vec3 v, double scalar);
+t_vec3	vec3_multiply(t_vec3 v, t_real scalar);
 /* Calculate dot product of two vectors */
-double	vec3_dot(t_vec3 a, t_vec3 b);
+t_real	vec3_dot(t_vec3 a, t_vec3 b);
 /* Calculate cross product of two vectors */
 t_vec3	vec3_cross(t_vec3 a, t_vec3 b);
 /* Calculate magnitude (length) of vector */
-double	vec3_magnitude(t_vec3 v);
+t_real	vec3_magnitude(t_vec3 v);
 /* Return normalized vector (length = 1) */
 t_vec3	vec3_normalize(t_vec3 v);
 
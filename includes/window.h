@@ -14,19 +14,27 @@
 # define WINDOW_H
 
 # include "minirt.h"
+# include "render_pool.h"
+# include "packet.h"
 
 /* Window resolution constants - MacBook M1 13-inch native resolution */
 # define WINDOW_WIDTH 1440
 # define WINDOW_HEIGHT 900
 # define ASPECT_RATIO (1440.0 / 900.0)
 
-/* Object type enumeration for selection */
+/*
+** Object type enumeration for selection and BVH references.
+** OBJ_INSTANCE and OBJ_TRIANGLE only appear in BVHs, never as a
+** selection; triangles only in the BVH of a group.
+*/
 typedef enum e_obj_type
 {
 	OBJ_NONE = 0,
 	OBJ_SPHERE,
 	OBJ_PLANE,
-	OBJ_CYLINDER
+	OBJ_CYLINDER,
+	OBJ_INSTANCE,
+	OBJ_TRIANGLE
 }	t_obj_type;
 
 /* Selected object information */
@@ -64,6 +72,19 @@ typedef struct s_keyguide_state
 	int		y;
 }	t_keyguide_state;
 
+/*
+** Camera basis for one frame: ray direction for pixel (x, y) is
+** corner + dx * x + dy * y (before normalization).
+** corner is the direction through the top-left pixel.
+*/
+typedef struct s_camera_frame
+{
+	t_vec3	origin;
+	t_vec3	corner;
+	t_vec3	dx;
+	t_vec3	dy;
+}	t_camera_frame;
+
 /* Render context containing MLX pointers and scene data */
 typedef struct s_render
 {
@@ -81,6 +102,9 @@ typedef struct s_render
 	int					shift_pressed;
 	t_hud_state			hud;
 	t_keyguide_state	keyguide;
+	t_render_pool		*pool;
+	t_camera_frame		camera;
+	t_packet_fn			packet;
 }	t_render;
 
 /* Initialize MLX window and set up event handlers */
@@ -93,6 +117,13 @@ int			handle_key(int keycode, void *param);
 int			handle_key_release(int keycode, void *param);
 /* Main rendering loop */
 int			render_loop(void *param);
+/* Precompute the per-frame camera basis used for primary rays */
+void		camera_frame_init(t_camera_frame *frame, t_camera *camera);
+/* Write one pixel of the frame buffer (ignores out-of-frame pixels) */
+void		put_pixel_to_buffer(t_render *render, int x, int y,
+				t_color color);
+/* Render one time-budgeted slice of the progressive pass */
+int			progressive_render_step(t_render *render);
 
 /* Initialize MLX connection */
 void		*mlx_init(void);
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# miniRT float vs double precision test
+# float 빌드와 double 빌드의 렌더 결과를 비교하는 스크립트
+
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+NC='\033[0m'
+
+SCENES="scenes/test_simple.rt scenes/perf_test_50_spheres.rt \
+scenes/us04_all_intersections.rt scenes/test_soft_shadows.rt"
+OUT_DIR=$(mktemp -d)
+FAILED=0
+
+trap 'rm -rf "$OUT_DIR"' EXIT
+
+echo -e "${BLUE}[1] Building double and float variants${NC}"
+make "$@" > /dev/null || exit 1
+make FLOAT=1 "$@" > /dev/null || exit 1
+cc -Wall -Wextra -Werror tests/test_float_precision.c \
+    -o "$OUT_DIR/test_float_precision" || exit 1
+
+echo -e "${BLUE}[2] Comparing renders${NC}"
+for scene in $SCENES; do
+    [ ! -f "$scene" ] && continue
+    name=$(basename "$scene" .rt)
+    ./miniRT --output "$OUT_DIR/$name.ppm" "$scene" || exit 1
+    ./miniRT_float --output "$OUT_DIR/${name}_float.ppm" "$scene" || exit 1
+    if "$OUT_DIR/test_float_precision" "$OUT_DIR/$name.ppm" \
+        "$OUT_DIR/${name}_float.ppm" > "$OUT_DIR/log" 2>&1; then
+        echo -e "${GREEN}✓${NC} $name $(grep mean "$OUT_DIR/log")"
+    else
+        echo -e "${RED}✗${NC} $name"
+        cat "$OUT_DIR/log"
+        FAILED=1
+    fi
+done
+exit $FAILED
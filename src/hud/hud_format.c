@@ -87,6 +87,11 @@ void	hud_format_float(char *buffer, double value)
 	ft_itoa_buf(buffer + i, frac_part);
 }
 
+void	hud_format_int(char *buffer, int value)
+{
+	ft_itoa_buf(buffer, value);
+}
+
 void	hud_format_vec3(char *buffer, t_vec3 vec)
 {
 	int	i;
@@ -142,11 +147,3 @@ void	hud_format_time_ms(char *buf, long time_us)
 	hud_format_float(buf, time_ms);
 }
 
-void	hud_format_bvh_status(char *buf, int enabled)
-{
-	if (enabled)
-		ft_strcpy(buf, "ON");
-	else
-		ft_strcpy(buf, "OFF");
-}
-
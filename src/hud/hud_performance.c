@@ -59,22 +59,99 @@ static void	render_perf_basic(t_render *render, int *y)
 	mlx_string_put(render->mlx, render->win,
 		HUD_MARGIN_X + 10, *y, HUD_COLOR_TEXT, line);
 	*y += HUD_LINE_HEIGHT;
-	hud_format_bvh_status(buf, render->scene->render_state.bvh_enabled);
-	i = 0;
-	j = 0;
-	while ("BVH: "[j])
-		line[i++] = "BVH: "[j++];
-	j = 0;
-	while (buf[j])
-		line[i++] = buf[j++];
+}
+
+/* Append str at line[i]; returns the new end of the line */
+static int	append(char *line, int i, const char *str)
+{
+	while (*str)
+		line[i++] = *str++;
 	line[i] = '\0';
+	return (i);
+}
+
+/* Append an integer (is_int) or a 2-decimal value at line[i] */
+static int	append_num(char *line, int i, double value, int is_int)
+{
+	if (is_int)
+		hud_format_int(line + i, (int)value);
+	else
+		hud_format_float(line + i, value);
+	while (line[i])
+		i++;
+	return (i);
+}
+
+static void	put_line(t_render *render, int *y, char *line)
+{
 	mlx_string_put(render->mlx, render->win,
 		HUD_MARGIN_X + 10, *y, HUD_COLOR_TEXT, line);
 	*y += HUD_LINE_HEIGHT;
 }
 
+/*
+** BVH quality figures. Counts, depths and leaf sizes come from
+** bvh_compute_stats at build or load and hold until the next rebuild,
+** since a refit keeps the topology; SAH and overlap also follow each
+** refit (bvh_stats_update_costs). Leaves of four or more share a bin.
+*/
+static void	render_perf_bvh(t_render *render, t_bvh_stats *st, int *y)
+{
+	char	line[128];
+	int		i;
+
+	i = append_num(line, append(line, 0, "Nodes: "), st->nodes, 1);
+	i = append_num(line, append(line, i, "  Leaves: "), st->leaves, 1);
+	put_line(render, y, line);
+	i = append_num(line, append(line, 0, "Leaf depth: "), st->min_depth, 1);
+	i = append_num(line, append(line, i, " / "), st->avg_depth, 0);
+	i = append_num(line, append(line, i, " / "), st->max_depth, 1);
+	put_line(render, y, line);
+	i = append_num(line, append(line, 0, "SAH: "), st->sah_cost, 0);
+	i = append_num(line, append(line, i, "  Overlap: "),
+			st->overlap_ratio * 100, 0);
+	append(line, i, "%");
+	put_line(render, y, line);
+	i = append_num(line, append(line, 0, "Leaf sizes 1:"), st->leaf_hist[0], 1);
+	i = append_num(line, append(line, i, " 2:"), st->leaf_hist[1], 1);
+	i = append_num(line, append(line, i, " 3:"), st->leaf_hist[2], 1);
+	i = append_num(line, append(line, i, " 4+:"), st->leaves
+			- st->leaf_hist[0] - st->leaf_hist[1] - st->leaf_hist[2], 1);
+	put_line(render, y, line);
+}
+
+/*
+** Active accelerator with its build time, memory and probe ray cost
+** (accel_probe), the figures to compare when cycling with M.
+*/
+static void	render_perf_accel(t_render *render, int *y)
+{
+	t_render_state	*state;
+	t_accel_stats	*st;
+	char			line[128];
+	int				i;
+
+	state = &render->scene->render_state;
+	st = &state->accel_stats[state->accel];
+	i = append(line, append(line, 0, "Accel: "),
+			accel_ops(state->accel)->name);
+	i = append_num(line, append(line, i, "  "), st->bytes / 1024.0, 0);
+	append(line, i, " KB");
+	put_line(render, y, line);
+	i = append_num(line, append(line, 0, "Build: "), st->build_ms, 0);
+	i = append_num(line, append(line, i, " ms  Probe: "), st->probe_us, 0);
+	append(line, i, " us/ray");
+	put_line(render, y, line);
+}
+
 void	hud_render_performance(t_render *render, int *y)
 {
+	t_bvh	*bvh;
+
 	render_perf_header(render, y);
 	render_perf_basic(render, y);
+	render_perf_accel(render, y);
+	bvh = render->scene->render_state.bvh;
+	if (render->scene->render_state.accel == ACCEL_BVH && bvh && bvh->nodes)
+		render_perf_bvh(render, &bvh->stats, y);
 }
@@ -104,6 +104,12 @@ void	keyguide_render_content2(t_render *render, int *y)
 	*y += KEYGUIDE_LINE_HEIGHT;
 	mlx_string_put(render->mlx, render->win,
 		render->keyguide.x + 20, *y, KEYGUIDE_COLOR_TEXT, "I - Info");
+	*y += KEYGUIDE_LINE_HEIGHT;
+	mlx_string_put(render->mlx, render->win,
+		render->keyguide.x + 20, *y, KEYGUIDE_COLOR_TEXT, "P - Progressive");
+	*y += KEYGUIDE_LINE_HEIGHT;
+	mlx_string_put(render->mlx, render->win,
+		render->keyguide.x + 20, *y, KEYGUIDE_COLOR_TEXT, "M - Accelerator");
 }
 
 void	keyguide_render(t_render *render)
@@ -53,6 +53,8 @@ static double	calculate_specular(t_vec3 light_dir, t_vec3 normal, \
 
 /*
 ** Calculate combined lighting factor (diffuse + specular - shadow).
+** A surface facing away from the light (N.L <= 0) gets no direct
+** light at all, so no shadow ray is cast for it.
 */
 static double	calc_lighting_factor(t_scene *scene, t_hit *hit, \
 		t_vec3 light_dir, t_vec3 view_dir)
@@ -62,8 +64,8 @@ static double	calc_lighting_factor(t_scene *scene, t_hit *hit, \
 	double	shadow_factor;
 
 	diffuse = vec3_dot(hit->normal, light_dir);
-	if (diffuse < 0)
-		diffuse = 0;
+	if (diffuse <= 0)
+		return (0.0);
 	shadow_factor = calculate_shadow_factor(scene, hit->point, \
 		scene->light.position, &scene->shadow_config);
 	specular = calculate_specular(light_dir, hit->normal, view_dir) * 0.5;
@@ -13,7 +13,6 @@
 #include "shadow.h"
 #include "minirt.h"
 #include "vec3.h"
-#include <math.h>
 
 /*
 ** Calculate adaptive shadow bias based on surface angle.
@@ -35,33 +34,6 @@ double	calculate_shadow_bias(t_vec3 normal, t_vec3 light_dir, \
 	return (bias);
 }
 
-/*
-** Generate offset vector for soft shadow sampling.
-** Uses stratified sampling in circular pattern around light.
-** Returns zero vector if only one sample requested.
-*/
-t_vec3	generate_shadow_sample_offset(double radius, int sample_index, \
-		int total_samples)
-{
-	t_vec3	offset;
-	double	angle;
-	double	r;
-	int		grid_size;
-
-	if (total_samples <= 1)
-		return ((t_vec3){0.0, 0.0, 0.0});
-	grid_size = (int)sqrt((double)total_samples);
-	if (grid_size < 1)
-		grid_size = 1;
-	angle = 2.0 * 3.14159265358979323846 * (sample_index % grid_size) \
-		/ (double)grid_size;
-	r = radius * (sample_index / (double)grid_size + 0.5) / (double)grid_size;
-	offset.x = r * cos(angle);
-	offset.y = r * sin(angle);
-	offset.z = 0.0;
-	return (offset);
-}
-
 /*
 ** Helper structure for shadow sampling parameters.
 */
@@ -72,51 +44,75 @@ typedef struct s_shadow_sample
 	t_vec3			light_pos;
 	t_shadow_config	*config;
 	double			bias;
+	t_vec3			axes[2];
 }	t_shadow_sample;
 
 /*
-** Cast single shadow ray with offset.
+** Cast single shadow ray toward table sample index on the light disk.
 */
 static int	sample_shadow_ray(t_shadow_sample *params, int index)
 {
-	t_vec3	offset;
+	double	*disk;
 	t_vec3	sample_light_pos;
 
-	offset = generate_shadow_sample_offset(params->config->softness * 2.0, \
-		index, params->config->samples);
-	sample_light_pos = vec3_add(params->light_pos, offset);
+	disk = params->config->disk[index];
+	sample_light_pos = vec3_add(params->light_pos, vec3_add(
+				vec3_multiply(params->axes[0], disk[0]),
+				vec3_multiply(params->axes[1], disk[1])));
 	return (is_in_shadow(params->scene, params->point, \
 		sample_light_pos, params->bias));
 }
 
 /*
-** Calculate shadow samples by casting rays to light positions.
+** Number of occluded samples among [from, to).
+*/
+static int	count_shadow_rays(t_shadow_sample *params, int from, int to)
+{
+	int	blocked;
+
+	blocked = 0;
+	while (from < to)
+	{
+		if (sample_shadow_ray(params, from))
+			blocked++;
+		from++;
+	}
+	return (blocked);
+}
+
+/*
+** Occluded samples out of config->samples, fired adaptively. The
+** table's first config->probes samples, the outermost of each sector
+** of the disk, are cast first. If they agree, the point is taken as
+** fully lit or fully shadowed: a convex occluder hides a convex part
+** of the light, so one covering every probe covers all but the thin
+** rim outside their hull. Only points whose probes disagree, in the
+** penumbra, cast the rest.
 */
 static double	calc_shadow_samples(t_scene *scene, t_vec3 point, \
 		t_vec3 light_pos, t_shadow_config *config)
 {
 	t_shadow_sample	params;
-	double			shadow_count;
-	t_vec3			normal;
 	t_vec3			light_dir;
-	int				i;
+	int				blocked;
 
-	shadow_count = 0.0;
 	light_dir = vec3_normalize(vec3_subtract(light_pos, point));
-	normal = (t_vec3){0.0, 1.0, 0.0};
 	params.scene = scene;
 	params.point = point;
 	params.light_pos = light_pos;
 	params.config = config;
-	params.bias = calculate_shadow_bias(normal, light_dir, 0.001);
-	i = 0;
-	while (i < config->samples)
-	{
-		if (sample_shadow_ray(&params, i))
-			shadow_count += 1.0;
-		i++;
-	}
-	return (shadow_count);
+	params.bias = calculate_shadow_bias((t_vec3){0.0, 1.0, 0.0}, \
+		light_dir, 0.001);
+	shadow_sample_axes(config, point, light_dir, params.axes);
+	if (config->probes < 2)
+		return (count_shadow_rays(&params, 0, config->samples));
+	blocked = count_shadow_rays(&params, 0, config->probes);
+	if (blocked == 0)
+		return (0.0);
+	if (blocked == config->probes)
+		return ((double)config->samples);
+	return (blocked + count_shadow_rays(&params, config->probes, \
+		config->samples));
 }
 
 /*
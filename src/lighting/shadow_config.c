@@ -25,18 +25,20 @@ t_shadow_config	init_shadow_config(void)
 	config.softness = 0.3;
 	config.bias_scale = 2.0;
 	config.enable_ao = 0;
+	shadow_build_table(&config);
 	return (config);
 }
 
 /*
 ** Validate shadow configuration parameters are within valid ranges.
-** Ensures samples >= 1, softness in [0.0, 1.0], and bias_scale >= 0.
+** Ensures samples in [1, SHADOW_MAX_SAMPLES], softness in [0.0, 1.0],
+** and bias_scale >= 0.
 */
 int	validate_shadow_config(t_shadow_config *config)
 {
 	if (!config)
 		return (0);
-	if (config->samples < 1)
+	if (config->samples < 1 || config->samples > SHADOW_MAX_SAMPLES)
 		return (0);
 	if (config->softness < 0.0 || config->softness > 1.0)
 		return (0);
@@ -48,19 +50,27 @@ int	validate_shadow_config(t_shadow_config *config)
 /*
 ** Set number of shadow samples for soft shadow quality.
 ** More samples = smoother shadows but slower rendering.
+** The sample table is rebuilt for the new count.
 */
 void	set_shadow_samples(t_shadow_config *config, int samples)
 {
-	if (config && samples >= 1)
+	if (config && samples >= 1 && samples <= SHADOW_MAX_SAMPLES)
+	{
 		config->samples = samples;
+		shadow_build_table(config);
+	}
 }
 
 /*
 ** Set shadow edge softness factor.
 ** 0.0 = hard edges, 1.0 = very soft edges.
+** The sample table is rebuilt for the new disk radius.
 */
 void	set_shadow_softness(t_shadow_config *config, double softness)
 {
 	if (config && softness >= 0.0 && softness <= 1.0)
+	{
 		config->softness = softness;
+		shadow_build_table(config);
+	}
 }
@@ -0,0 +1,233 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shadow_table.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:22:47 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 15:22:47 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "shadow.h"
+#include "vec3.h"
+#include <math.h>
+#include <string.h>
+
+/*
+** Point i of the 2D Sobol sequence in [0, 1)^2. The first dimension
+** is the base-2 van der Corput sequence; the second uses the direction
+** numbers of x + 1 (v_k = v_k-1 ^ v_k-1 >> 1). Any 2^k leading points
+** form a (0, k, 2)-net: every 1/2^k-area box of the square holds one.
+*/
+static void	sobol_point(unsigned int i, double out[2])
+{
+	unsigned int	x;
+	unsigned int	y;
+	unsigned int	dx;
+	unsigned int	dy;
+
+	x = 0;
+	y = 0;
+	dx = 1u << 31;
+	dy = 1u << 31;
+	while (i)
+	{
+		if (i & 1)
+		{
+			x ^= dx;
+			y ^= dy;
+		}
+		i >>= 1;
+		dx >>= 1;
+		dy ^= dy >> 1;
+	}
+	out[0] = x / 4294967296.0;
+	out[1] = y / 4294967296.0;
+}
+
+/*
+** Shirley and Chiu's concentric map from [0, 1)^2 onto the unit disk,
+** scaled by radius. It keeps areas and strata, so the net stays
+** evenly spread over the disk.
+*/
+static void	concentric_disk(double u, double v, double radius, double out[2])
+{
+	double	a;
+	double	b;
+	double	r;
+	double	phi;
+
+	a = 2.0 * u - 1.0;
+	b = 2.0 * v - 1.0;
+	out[0] = 0.0;
+	out[1] = 0.0;
+	if (a == 0.0 && b == 0.0)
+		return ;
+	r = b;
+	phi = M_PI / 2.0 - M_PI / 4.0 * (a / b);
+	if (fabs(a) > fabs(b))
+	{
+		r = a;
+		phi = M_PI / 4.0 * (b / a);
+	}
+	out[0] = radius * r * cos(phi);
+	out[1] = radius * r * sin(phi);
+}
+
+/* Squared distance of a disk sample from the light's centre */
+static double	disk_r2(const double *p)
+{
+	return (p[0] * p[0] + p[1] * p[1]);
+}
+
+/*
+** Sample among [from, samples) farthest from the centre within
+** sector of sectors equal sectors; any sector if sector < 0.
+** Returns -1 if the sector holds none of them.
+*/
+static int	farthest_in_sector(t_shadow_config *config, int from, int sector,
+		int sectors)
+{
+	double	*p;
+	int		best;
+	int		i;
+	int		inside;
+
+	best = -1;
+	i = from - 1;
+	while (++i < config->samples)
+	{
+		p = config->disk[i];
+		inside = (sector < 0 || (int)((atan2(p[1], p[0]) + M_PI)
+					/ (2.0 * M_PI) * sectors) == sector);
+		if (inside && (best < 0 || disk_r2(p) > disk_r2(config->disk[best])))
+			best = i;
+	}
+	return (best);
+}
+
+/* Swap table samples a and b, keeping the sample set as it is */
+static void	swap_samples(t_shadow_config *config, int a, int b)
+{
+	double	tmp[2];
+
+	memcpy(tmp, config->disk[a], sizeof(tmp));
+	memcpy(config->disk[a], config->disk[b], sizeof(tmp));
+	memcpy(config->disk[b], tmp, sizeof(tmp));
+}
+
+/*
+** Move the probes to the front of the table: for each of sectors equal
+** sectors of the disk, its outermost sample (the outermost one left
+** if the sector is empty), then the sample closest to the centre.
+** The outer ones hull nearly all of the disk, so an occluder covering
+** them covers the rest; the centre one catches thin occluders that
+** cross the light between them.
+*/
+static void	order_probes(t_shadow_config *config, int sectors)
+{
+	int	best;
+	int	k;
+	int	i;
+
+	k = -1;
+	while (++k < sectors)
+	{
+		best = farthest_in_sector(config, k, k, sectors);
+		if (best < 0)
+			best = farthest_in_sector(config, k, -1, sectors);
+		swap_samples(config, k, best);
+	}
+	best = sectors;
+	i = sectors;
+	while (++i < config->samples)
+	{
+		if (disk_r2(config->disk[i]) < disk_r2(config->disk[best]))
+			best = i;
+	}
+	swap_samples(config, sectors, best);
+	config->probes = sectors + 1;
+}
+
+/*
+** The table behind calc_shadow_samples: samples Sobol points on the
+** light disk (radius softness * 2), centred in their strata; a single
+** sample stays at the light's centre for hard shadows. Tables of 4
+** samples or more lead with floor(sqrt(samples)) + 1 probes; smaller
+** ones have a single probe, which means every sample is cast.
+*/
+void	shadow_build_table(t_shadow_config *config)
+{
+	double	uv[2];
+	int		i;
+
+	i = -1;
+	while (++i < SHADOW_ROTATIONS)
+	{
+		config->rotation[i][0] = cos(2.0 * M_PI * i / SHADOW_ROTATIONS);
+		config->rotation[i][1] = sin(2.0 * M_PI * i / SHADOW_ROTATIONS);
+	}
+	config->disk[0][0] = 0.0;
+	config->disk[0][1] = 0.0;
+	i = -1;
+	while (config->samples > 1 && ++i < config->samples)
+	{
+		sobol_point(i, uv);
+		concentric_disk(fmod(uv[0] + 0.5 / config->samples, 1.0),
+			fmod(uv[1] + 0.5 / config->samples, 1.0),
+			config->softness * 2.0, config->disk[i]);
+	}
+	config->probes = 1;
+	if (config->samples >= 4)
+		order_probes(config, (int)sqrt((double)config->samples));
+}
+
+/*
+** Rotation index of a shaded point: FNV-1a over the bytes of its
+** coordinates. Stable for a point across frames, unrelated between
+** neighbouring pixels.
+*/
+static int	rotation_index(t_vec3 point)
+{
+	unsigned char	bytes[sizeof(t_vec3)];
+	unsigned int	h;
+	size_t			i;
+
+	memcpy(bytes, &point, sizeof(bytes));
+	h = 2166136261u;
+	i = 0;
+	while (i < sizeof(bytes))
+	{
+		h = (h ^ bytes[i]) * 16777619u;
+		i++;
+	}
+	return ((h ^ h >> 16) % SHADOW_ROTATIONS);
+}
+
+/*
+** Orthonormal pair across the unit light_dir without a square root
+** (Duff et al., "Building an Orthonormal Basis, Revisited"), turned
+** by the point's rotation: a Cranley-Patterson shift of the angle.
+*/
+void	shadow_sample_axes(const t_shadow_config *config, t_vec3 point,
+		t_vec3 light_dir, t_vec3 axes[2])
+{
+	const double	*rot;
+	double			sign;
+	double			a;
+	t_vec3			u;
+	t_vec3			v;
+
+	sign = copysign(1.0, light_dir.z);
+	a = -1.0 / (sign + light_dir.z);
+	u = (t_vec3){1.0 + sign * light_dir.x * light_dir.x * a,
+		sign * light_dir.x * light_dir.y * a, -sign * light_dir.x};
+	v = (t_vec3){light_dir.x * light_dir.y * a,
+		sign + light_dir.y * light_dir.y * a, -light_dir.y};
+	rot = config->rotation[rotation_index(point)];
+	axes[0] = vec3_add(vec3_multiply(u, rot[0]), vec3_multiply(v, rot[1]));
+	axes[1] = vec3_subtract(vec3_multiply(v, rot[0]),
+			vec3_multiply(u, rot[1]));
+}
@@ -14,19 +14,21 @@
 #include "minirt.h"
 #include "vec3.h"
 #include "ray.h"
+#include "spatial.h"
 
 /*
-** Check if shadow ray intersects any sphere in the scene.
+** Check if shadow ray intersects any cylinder closer than max_distance.
 ** Returns 1 if intersection found, 0 otherwise.
 */
-static int	check_sphere_shadow(t_scene *scene, t_ray *ray, t_hit *hit)
+static int	check_cylinder_shadow(t_scene *scene, t_ray *ray,
+		t_real max_distance)
 {
 	int	i;
 
 	i = 0;
-	while (i < scene->sphere_count)
+	while (i < scene->cylinder_count)
 	{
-		if (intersect_sphere(ray, &scene->spheres[i], hit))
+		if (cylinder_occludes(ray, &scene->cylinders[i], max_distance))
 			return (1);
 		i++;
 	}
@@ -34,17 +36,20 @@ static int	check_sphere_shadow(t_scene *scene, t_ray *ray, t_hit *hit)
 }
 
 /*
-** Check if shadow ray intersects any plane in the scene.
+** Check if shadow ray intersects any instance closer than
+** max_distance, through each group's occlusion walk.
 ** Returns 1 if intersection found, 0 otherwise.
 */
-static int	check_plane_shadow(t_scene *scene, t_ray *ray, t_hit *hit)
+static int	check_instance_shadow(t_scene *scene, t_ray *ray,
+		t_real max_distance)
 {
 	int	i;
 
 	i = 0;
-	while (i < scene->plane_count)
+	while (i < scene->instance_count)
 	{
-		if (intersect_plane(ray, &scene->planes[i], hit))
+		if (instance_occludes(scene, &scene->instances[i], ray,
+				max_distance))
 			return (1);
 		i++;
 	}
@@ -52,45 +57,39 @@ static int	check_plane_shadow(t_scene *scene, t_ray *ray, t_hit *hit)
 }
 
 /*
-** Check if shadow ray intersects any cylinder in the scene.
-** Returns 1 if intersection found, 0 otherwise.
+** Any bounded object closer than max_distance, by brute force: the
+** occlusion query of the "none" accelerator. Spheres use the SIMD
+** kernel on the SoA arrays.
 */
-static int	check_cylinder_shadow(t_scene *scene, t_ray *ray, t_hit *hit)
+int	objects_occlude(t_scene *scene, t_ray *ray, t_real max_distance)
 {
-	int	i;
-
-	i = 0;
-	while (i < scene->cylinder_count)
-	{
-		if (intersect_cylinder(ray, &scene->cylinders[i], hit))
-			return (1);
-		i++;
-	}
-	return (0);
+	if (spheres_occlude(scene, ray, max_distance))
+		return (1);
+	if (check_cylinder_shadow(scene, ray, max_distance))
+		return (1);
+	return (check_instance_shadow(scene, ray, max_distance));
 }
 
 /*
 ** Test if point is occluded from light source.
-** Casts shadow ray from point toward light.
+** Casts shadow ray from point toward light; planes are tested in
+** their own loop, everything else through the active accelerator.
 ** Returns 1 if any object blocks the light, 0 if fully lit.
 */
 int	is_in_shadow(t_scene *scene, t_vec3 point, t_vec3 light_pos, double bias)
 {
 	t_ray	shadow_ray;
-	t_hit	shadow_hit;
 	t_vec3	to_light;
 	t_vec3	light_dir;
+	t_real	distance;
 
 	to_light = vec3_subtract(light_pos, point);
-	shadow_hit.distance = vec3_magnitude(to_light);
+	distance = vec3_magnitude(to_light);
 	light_dir = vec3_normalize(to_light);
 	shadow_ray.origin = vec3_add(point, vec3_multiply(light_dir, bias));
 	shadow_ray.direction = light_dir;
-	if (check_sphere_shadow(scene, &shadow_ray, &shadow_hit))
-		return (1);
-	if (check_plane_shadow(scene, &shadow_ray, &shadow_hit))
+	if (planes_occlude(scene, &shadow_ray, distance))
 		return (1);
-	if (check_cylinder_shadow(scene, &shadow_ray, &shadow_hit))
-		return (1);
-	return (0);
+	ray_prepare(&shadow_ray);
+	return (accel_occluded(scene, &shadow_ray, distance));
 }
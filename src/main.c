@@ -14,65 +14,74 @@
 #include "parser.h"
 #include "window.h"
 #include "spatial.h"
+#include "options.h"
+#include "image.h"
+#include "batch.h"
 #include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
 
 /*
-** Initialize scene structure with default values.
-** Allocates memory and sets all counters to zero.
-** Returns NULL on allocation failure.
+** Batch mode owns its own scene list; release the options afterwards.
 */
-static t_scene	*init_scene(void)
+static int	run_batch(t_options *opts)
 {
-	t_scene	*scene;
+	int	status;
 
-	scene = malloc(sizeof(t_scene));
-	if (!scene)
-		return (NULL);
-	memset(scene, 0, sizeof(t_scene));
-	scene->sphere_count = 0;
-	scene->plane_count = 0;
-	scene->cylinder_count = 0;
-	scene->has_ambient = 0;
-	scene->has_camera = 0;
-	scene->has_light = 0;
-	scene->shadow_config = init_shadow_config();
-	render_state_init(&scene->render_state);
-	scene->render_state.bvh_enabled = 1;
-	return (scene);
+	status = batch_run(opts);
+	options_cleanup(opts);
+	return (status);
 }
 
 /*
 ** Main program entry point.
 ** Validates arguments, initializes scene, parses input file,
-** creates window, and starts rendering loop.
+** creates window and render workers, and starts rendering loop.
+** With --output the frame is rendered offline and no window is opened;
+** with --batch every listed scene is rendered offline in turn.
 */
 int	main(int argc, char **argv)
 {
 	t_scene		*scene;
 	t_render	*render;
+	t_options	opts;
 
-	if (argc != 2)
+	if (!parse_options(argc, argv, &opts))
 	{
-		printf("Usage: %s <scene_file.rt>\n", argv[0]);
+		print_usage(argv[0]);
 		return (1);
 	}
+	if (opts.batch_dir)
+		return (run_batch(&opts));
+	options_cleanup(&opts);
 	scene = init_scene();
 	if (!scene)
 		return (print_error("Failed to initialize scene"));
-	if (!parse_scene(argv[1], scene))
+	if (!parse_scene(opts.scene_file, scene))
 	{
 		cleanup_scene(scene);
 		return (1);
 	}
-	scene_build_bvh(scene);
+	scene->render_state.accel = opts.accel;
+	scene->render_state.bvh_config = opts.bvh;
+	if (opts.bvh.cache)
+		scene->render_state.bvh_cache = bvh_cache_path(opts.scene_file);
+	scene_build_accel(scene);
+	scene_report_accel(scene);
+	if (opts.output_file)
+		return (render_headless(scene, &opts));
 	render = init_window(scene);
 	if (!render)
 	{
 		cleanup_scene(scene);
 		return (print_error("Failed to initialize window"));
 	}
+	render->pool = render_pool_create(opts.thread_count);
+	if (!render->pool)
+	{
+		print_error("Failed to start render threads");
+		cleanup_all(scene, render);
+		return (1);
+	}
+	render->packet = packet_select_kernel(opts.simd);
 	render_scene(scene, render->mlx, render->win);
 	mlx_loop(render->mlx);
 	return (0);
@@ -44,7 +44,7 @@ t_vec3	vec3_subtract(t_vec3 a, t_vec3 b)
 ** Multiply vector by scalar value.
 ** Returns new vector: (v.x * scalar, v.y * scalar, v.z * scalar)
 */
-t_vec3	vec3_multiply(t_vec3 v, double scalar)
+t_vec3	vec3_multiply(t_vec3 v, t_real scalar)
 {
 	t_vec3	result;
 
@@ -18,7 +18,7 @@
 ** Returns scalar: a.x * b.x + a.y * b.y + a.z * b.z
 ** Used for projections and angle calculations.
 */
-double	vec3_dot(t_vec3 a, t_vec3 b)
+t_real	vec3_dot(t_vec3 a, t_vec3 b)
 {
 	return (a.x * b.x + a.y * b.y + a.z * b.z);
 }
@@ -42,9 +42,9 @@ t_vec3	vec3_cross(t_vec3 a, t_vec3 b)
 ** Calculate magnitude (length) of vector.
 ** Returns sqrt(x² + y² + z²)
 */
-double	vec3_magnitude(t_vec3 v)
+t_real	vec3_magnitude(t_vec3 v)
 {
-	return (sqrt(v.x * v.x + v.y * v.y + v.z * v.z));
+	return (REAL_SQRT(v.x * v.x + v.y * v.y + v.z * v.z));
 }
 
 /*
@@ -53,11 +53,11 @@ double	vec3_magnitude(t_vec3 v)
 */
 t_vec3	vec3_normalize(t_vec3 v)
 {
-	double	mag;
+	t_real	mag;
 	t_vec3	result;
 
 	mag = vec3_magnitude(v);
-	if (mag > 0.0)
+	if (mag > 0)
 	{
 		result.x = v.x / mag;
 		result.y = v.y / mag;
@@ -65,9 +65,9 @@ t_vec3	vec3_normalize(t_vec3 v)
 	}
 	else
 	{
-		result.x = 0.0;
-		result.y = 0.0;
-		result.z = 0.0;
+		result.x = 0;
+		result.y = 0;
+		result.z = 0;
 	}
 	return (result);
 }
@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/08 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/08 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "batch.h"
+#include "image.h"
+#include "metrics.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+static void	report_job(t_batch *batch, int index)
+{
+	t_batch_job	*job;
+
+	job = &batch->jobs[index];
+	printf("[%d/%d] %s", index + 1, batch->count, job->path);
+	if (!job->ok)
+		printf("  FAILED\n");
+	else if (job->accel == ACCEL_BVH)
+		printf("  parse %.2f ms  bvh %.2f ms (SAH %.2f)  render %.2f ms  "
+			"write %.2f ms  -> %s\n", job->parse_ms, job->accel_ms,
+			job->bvh_cost, job->render_ms, job->write_ms, job->out);
+	else
+		printf("  parse %.2f ms  %s %.2f ms  render %.2f ms  write %.2f ms"
+			"  -> %s\n", job->parse_ms, accel_ops(job->accel)->name,
+			job->accel_ms, job->render_ms, job->write_ms, job->out);
+	if (job->ok && job->bvh.stats && job->scene->render_state.bvh)
+		bvh_print_stats(job->scene->render_state.bvh);
+	fflush(stdout);
+}
+
+/*
+** Render a loaded job into the shared framebuffer, write it out,
+** report timings and release the scene.
+*/
+static void	render_job(t_batch *batch, t_render *render, int index)
+{
+	t_batch_job		*job;
+	struct timeval	start;
+
+	job = &batch->jobs[index];
+	if (job->ok)
+	{
+		timer_start(&start);
+		render_scene_to_buffer(job->scene, render);
+		job->render_ms = timer_elapsed_ms(&start);
+		timer_start(&start);
+		job->ok = image_write(job->out, render);
+		job->write_ms = timer_elapsed_ms(&start);
+	}
+	report_job(batch, index);
+	cleanup_scene(job->scene);
+	job->scene = NULL;
+	batch->failures += !job->ok;
+}
+
+/*
+** Shared render context: one framebuffer and one worker pool for
+** the whole batch.
+*/
+static t_render	*batch_setup(t_batch *batch, t_options *opts)
+{
+	t_render	*render;
+
+	memset(batch, 0, sizeof(t_batch));
+	batch->out_dir = opts->batch_dir;
+	batch->accel = opts->accel;
+	batch->bvh = opts->bvh;
+	if (!batch_collect_jobs(batch, opts))
+		return (NULL);
+	mkdir(batch->out_dir, 0755);
+	render = init_headless(NULL);
+	if (render)
+		render->pool = render_pool_create(opts->thread_count);
+	if (!render || !render->pool)
+	{
+		cleanup_render(render);
+		print_error("Failed to start batch renderer");
+		return (NULL);
+	}
+	render->packet = packet_select_kernel(opts->simd);
+	return (render);
+}
+
+int	batch_run(t_options *opts)
+{
+	t_batch			batch;
+	t_render		*render;
+	struct timeval	start;
+	int				i;
+
+	render = batch_setup(&batch, opts);
+	if (!render)
+	{
+		batch_cleanup(&batch);
+		return (1);
+	}
+	timer_start(&start);
+	batch_prefetch(&batch, 0);
+	i = 0;
+	while (i < batch.count)
+	{
+		batch_wait(&batch);
+		batch_prefetch(&batch, i + 1);
+		render_job(&batch, render, i);
+		i++;
+	}
+	printf("Batch: %d scenes, %d failed, %.2f ms total\n", batch.count,
+		batch.failures, timer_elapsed_ms(&start));
+	cleanup_render(render);
+	batch_cleanup(&batch);
+	return (batch.failures != 0);
+}
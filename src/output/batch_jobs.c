@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_jobs.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/08 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/08 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "batch.h"
+#include "spatial.h"
+#include "metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int	add_job(t_batch *batch, const char *path, size_t len)
+{
+	t_batch_job	*grown;
+
+	if (batch->count == batch->capacity)
+	{
+		batch->capacity = batch->capacity * 2 + 16;
+		grown = realloc(batch->jobs, sizeof(t_batch_job) * batch->capacity);
+		if (!grown)
+			return (print_error("Out of memory"));
+		batch->jobs = grown;
+	}
+	memset(&batch->jobs[batch->count], 0, sizeof(t_batch_job));
+	batch->jobs[batch->count].path = strndup(path, len);
+	if (!batch->jobs[batch->count].path)
+		return (print_error("Out of memory"));
+	batch->count++;
+	return (1);
+}
+
+/*
+** Read the whole manifest into a NUL-terminated buffer.
+** Returns NULL if the file cannot be opened or read.
+*/
+static char	*read_manifest(const char *path)
+{
+	char	*data;
+	char	*grown;
+	size_t	len;
+	ssize_t	bytes;
+	int		fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	len = 0;
+	bytes = 0;
+	data = malloc(4097);
+	while (data)
+	{
+		bytes = read(fd, data + len, 4096);
+		if (bytes <= 0)
+			break ;
+		len += bytes;
+		grown = realloc(data, len + 4097);
+		if (!grown)
+			free(data);
+		data = grown;
+	}
+	close(fd);
+	if (data && bytes < 0)
+	{
+		free(data);
+		return (NULL);
+	}
+	if (data)
+		data[len] = '\0';
+	return (data);
+}
+
+/*
+** Manifest format: one scene path per line. Surrounding blanks are
+** ignored, as are empty lines and lines starting with '#'.
+*/
+static int	load_manifest(t_batch *batch, const char *path)
+{
+	char	*data;
+	char	*line;
+	size_t	len;
+	int		ok;
+
+	data = read_manifest(path);
+	if (!data)
+		return (print_error("Cannot read manifest"));
+	ok = 1;
+	line = data;
+	while (ok && *line)
+	{
+		while (*line == ' ' || *line == '\t' || *line == '\r')
+			line++;
+		len = strcspn(line, "\n");
+		while (len > 0 && strchr(" \t\r", line[len - 1]))
+			len--;
+		if (len > 0 && *line != '#')
+			ok = add_job(batch, line, len);
+		line += strcspn(line, "\n");
+		if (*line)
+			line++;
+	}
+	free(data);
+	return (ok);
+}
+
+int	batch_collect_jobs(t_batch *batch, t_options *opts)
+{
+	int	i;
+
+	if (opts->manifest && !load_manifest(batch, opts->manifest))
+		return (0);
+	i = 0;
+	while (i < opts->scene_count)
+	{
+		if (!add_job(batch, opts->scene_files[i],
+				strlen(opts->scene_files[i])))
+			return (0);
+		i++;
+	}
+	if (batch->count == 0)
+		return (print_error("Batch has no scenes"));
+	return (batch_name_outputs(batch));
+}
+
+void	batch_cleanup(t_batch *batch)
+{
+	int	i;
+
+	batch_wait(batch);
+	i = 0;
+	while (i < batch->count)
+	{
+		cleanup_scene(batch->jobs[i].scene);
+		free(batch->jobs[i].path);
+		free(batch->jobs[i].out);
+		i++;
+	}
+	free(batch->jobs);
+	batch->jobs = NULL;
+	batch->count = 0;
+}
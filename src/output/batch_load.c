@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_load.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/08 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/08 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "batch.h"
+#include "parser.h"
+#include "spatial.h"
+#include "metrics.h"
+
+/*
+** Parse one scene and build its accelerator, timing both stages and
+** keeping the BVH's SAH cost for the report.
+** Touches only the job's own scene, so it can run on the loader
+** thread while the render pool works on the previous scene.
+*/
+static void	load_job(t_batch_job *job)
+{
+	struct timeval	start;
+
+	timer_start(&start);
+	job->scene = init_scene();
+	job->ok = job->scene && parse_scene(job->path, job->scene);
+	job->parse_ms = timer_elapsed_ms(&start);
+	if (!job->ok)
+		return ;
+	job->scene->render_state.accel = job->accel;
+	job->scene->render_state.bvh_config = job->bvh;
+	if (job->bvh.cache)
+		job->scene->render_state.bvh_cache = bvh_cache_path(job->path);
+	timer_start(&start);
+	scene_build_accel(job->scene);
+	job->accel_ms = timer_elapsed_ms(&start);
+	job->bvh_cost = 0;
+	if (job->scene->render_state.bvh)
+		job->bvh_cost = job->scene->render_state.bvh->build_cost;
+}
+
+static void	*loader_main(void *arg)
+{
+	load_job((t_batch_job *)arg);
+	return (NULL);
+}
+
+void	batch_prefetch(t_batch *batch, int index)
+{
+	if (index >= batch->count)
+		return ;
+	batch->jobs[index].accel = batch->accel;
+	batch->jobs[index].bvh = batch->bvh;
+	if (pthread_create(&batch->loader, NULL, loader_main,
+			&batch->jobs[index]) == 0)
+	{
+		batch->loader_running = 1;
+		return ;
+	}
+	load_job(&batch->jobs[index]);
+}
+
+void	batch_wait(t_batch *batch)
+{
+	if (!batch->loader_running)
+		return ;
+	pthread_join(batch->loader, NULL);
+	batch->loader_running = 0;
+}
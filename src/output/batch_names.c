@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_names.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:05:41 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 12:05:41 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "batch.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** Build "<dir>/<scene basename without .rt>.ppm", or with "-<n>"
+** before the extension when n > 1.
+*/
+static char	*output_path(const char *dir, const char *scene, int n)
+{
+	const char	*base;
+	char		*path;
+	size_t		len;
+	size_t		size;
+
+	base = strrchr(scene, '/');
+	if (base)
+		base++;
+	else
+		base = scene;
+	len = strlen(base);
+	if (len > 3 && strcmp(base + len - 3, ".rt") == 0)
+		len -= 3;
+	size = strlen(dir) + len + 18;
+	path = malloc(size);
+	if (path && n > 1)
+		snprintf(path, size, "%s/%.*s-%d.ppm", dir, (int)len, base, n);
+	else if (path)
+		snprintf(path, size, "%s/%.*s.ppm", dir, (int)len, base);
+	return (path);
+}
+
+/* Whether one of the first count jobs already writes to path */
+static int	path_taken(t_batch *batch, int count, const char *path)
+{
+	int	i;
+
+	i = 0;
+	while (i < count)
+	{
+		if (strcmp(batch->jobs[i].out, path) == 0)
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/*
+** Images are named after their scene file, so a/scene.rt and
+** b/scene.rt would overwrite each other; the first job keeps the plain
+** name and each later one takes the first free "-2", "-3"... suffix.
+*/
+int	batch_name_outputs(t_batch *batch)
+{
+	t_batch_job	*job;
+	int			n;
+	int			i;
+
+	i = 0;
+	while (i < batch->count)
+	{
+		job = &batch->jobs[i];
+		n = 1;
+		job->out = output_path(batch->out_dir, job->path, n);
+		while (job->out && path_taken(batch, i, job->out))
+		{
+			free(job->out);
+			job->out = output_path(batch->out_dir, job->path, ++n);
+		}
+		if (!job->out)
+			return (print_error("Out of memory"));
+		i++;
+	}
+	return (1);
+}
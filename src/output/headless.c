@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   headless.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/07 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/07 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "image.h"
+#include <stdlib.h>
+
+/*
+** Build a render context around a plain framebuffer laid out like
+** an MLX image (32 bpp, one int per pixel), so the tile renderer
+** and image writers work unchanged. mlx, win and img stay NULL.
+*/
+t_render	*init_headless(t_scene *scene)
+{
+	t_render	*render;
+
+	render = calloc(1, sizeof(t_render));
+	if (!render)
+		return (NULL);
+	render->bpp = 32;
+	render->size_line = WINDOW_WIDTH * 4;
+	render->img_data = malloc((size_t)render->size_line * WINDOW_HEIGHT);
+	if (!render->img_data)
+	{
+		free(render);
+		return (NULL);
+	}
+	render->scene = scene;
+	return (render);
+}
+
+/*
+** Offline mode: one full-quality frame with the tile pool, written
+** to opts->output_file. Never touches MiniLibX or the X server.
+*/
+int	render_headless(t_scene *scene, t_options *opts)
+{
+	t_render	*render;
+	int			ok;
+
+	render = init_headless(scene);
+	if (!render)
+	{
+		cleanup_scene(scene);
+		print_error("Failed to allocate framebuffer");
+		return (1);
+	}
+	render->pool = render_pool_create(opts->thread_count);
+	if (!render->pool)
+	{
+		cleanup_all(scene, render);
+		print_error("Failed to start render threads");
+		return (1);
+	}
+	render->packet = packet_select_kernel(opts->simd);
+	render_scene_to_buffer(scene, render);
+	ok = image_write(opts->output_file, render);
+	cleanup_all(scene, render);
+	return (!ok);
+}
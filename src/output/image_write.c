@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_write.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/07 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/07 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "image.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+** Unpack one framebuffer row (0x00RRGGBB ints) into RGB bytes.
+*/
+void	image_pack_row(t_render *render, unsigned char *dst, int y)
+{
+	int				x;
+	unsigned int	pixel;
+
+	x = 0;
+	while (x < WINDOW_WIDTH)
+	{
+		pixel = *(unsigned int *)(render->img_data + y * render->size_line
+				+ x * (render->bpp / 8));
+		dst[x * 3] = (pixel >> 16) & 0xFF;
+		dst[x * 3 + 1] = (pixel >> 8) & 0xFF;
+		dst[x * 3 + 2] = pixel & 0xFF;
+		x++;
+	}
+}
+
+int	image_write_file(const char *path, unsigned char *data, size_t len)
+{
+	int		fd;
+	ssize_t	written;
+	size_t	total;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (print_error("Cannot open output file"));
+	total = 0;
+	while (total < len)
+	{
+		written = write(fd, data + total, len - total);
+		if (written <= 0)
+		{
+			close(fd);
+			return (print_error("Failed to write output file"));
+		}
+		total += written;
+	}
+	close(fd);
+	return (1);
+}
+
+/*
+** Binary PPM: "P6\n<w> <h>\n255\n" followed by raw RGB rows.
+** The whole file is assembled in memory and written at once.
+*/
+int	image_write_ppm(const char *path, t_render *render)
+{
+	unsigned char	*data;
+	int				header;
+	int				y;
+	int				ok;
+
+	data = malloc(64 + (size_t)WINDOW_WIDTH * WINDOW_HEIGHT * 3);
+	if (!data)
+		return (print_error("Out of memory writing image"));
+	header = snprintf((char *)data, 64, "P6\n%d %d\n255\n",
+			WINDOW_WIDTH, WINDOW_HEIGHT);
+	y = 0;
+	while (y < WINDOW_HEIGHT)
+	{
+		image_pack_row(render, data + header + (size_t)y * WINDOW_WIDTH * 3,
+			y);
+		y++;
+	}
+	ok = image_write_file(path, data,
+			header + (size_t)WINDOW_WIDTH * WINDOW_HEIGHT * 3);
+	free(data);
+	return (ok);
+}
+
+static int	has_suffix(const char *str, const char *suffix)
+{
+	size_t	len;
+	size_t	suffix_len;
+
+	len = strlen(str);
+	suffix_len = strlen(suffix);
+	if (len < suffix_len)
+		return (0);
+	return (strcmp(str + len - suffix_len, suffix) == 0);
+}
+
+int	image_write(const char *path, t_render *render)
+{
+	if (has_suffix(path, ".png") || has_suffix(path, ".PNG"))
+		return (image_write_png(path, render));
+	return (image_write_ppm(path, render));
+}
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   png_write.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/07 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/07 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "image.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Largest payload of a stored (uncompressed) deflate block */
+#define PNG_STORED_MAX 65535
+
+/* PNG output buffer with the CRC-32 lookup table used for chunks */
+typedef struct s_png
+{
+	unsigned char	*data;
+	size_t			len;
+	unsigned int	crc_table[256];
+}	t_png;
+
+static void	put_u32(unsigned char *dst, unsigned int value)
+{
+	dst[0] = (value >> 24) & 0xFF;
+	dst[1] = (value >> 16) & 0xFF;
+	dst[2] = (value >> 8) & 0xFF;
+	dst[3] = value & 0xFF;
+}
+
+/*
+** Close the chunk whose length field starts at offset start:
+** fill in the payload length and append CRC-32 of type + payload.
+*/
+static void	end_chunk(t_png *png, size_t start)
+{
+	unsigned int	crc;
+	size_t			i;
+
+	put_u32(png->data + start, (unsigned int)(png->len - start - 8));
+	crc = 0xFFFFFFFFu;
+	i = start + 4;
+	while (i < png->len)
+	{
+		crc = png->crc_table[(crc ^ png->data[i]) & 0xFF] ^ (crc >> 8);
+		i++;
+	}
+	put_u32(png->data + png->len, crc ^ 0xFFFFFFFFu);
+	png->len += 4;
+}
+
+static size_t	begin_chunk(t_png *png, const char *type)
+{
+	size_t	start;
+
+	start = png->len;
+	memcpy(png->data + png->len + 4, type, 4);
+	png->len += 8;
+	return (start);
+}
+
+/*
+** Emit the raw filtered scanlines as a zlib stream made of stored
+** deflate blocks, followed by the Adler-32 of the raw data.
+*/
+static void	store_zlib(t_png *png, unsigned char *raw, size_t raw_len)
+{
+	size_t			pos;
+	size_t			n;
+	unsigned int	a;
+	unsigned int	b;
+
+	png->data[png->len++] = 0x78;
+	png->data[png->len++] = 0x01;
+	pos = 0;
+	while (pos < raw_len)
+	{
+		n = raw_len - pos;
+		if (n > PNG_STORED_MAX)
+			n = PNG_STORED_MAX;
+		png->data[png->len++] = (pos + n == raw_len);
+		png->data[png->len++] = n & 0xFF;
+		png->data[png->len++] = (n >> 8) & 0xFF;
+		png->data[png->len++] = ~n & 0xFF;
+		png->data[png->len++] = (~n >> 8) & 0xFF;
+		memcpy(png->data + png->len, raw + pos, n);
+		png->len += n;
+		pos += n;
+	}
+	a = 1;
+	b = 0;
+	pos = 0;
+	while (pos < raw_len)
+	{
+		a = (a + raw[pos++]) % 65521;
+		b = (b + a) % 65521;
+	}
+	put_u32(png->data + png->len, (b << 16) | a);
+	png->len += 4;
+}
+
+/*
+** Build filtered scanlines (filter type 0 = None, then RGB bytes)
+** and the CRC table. Returns the raw buffer or NULL.
+*/
+static unsigned char	*prepare_png(t_png *png, t_render *render,
+		size_t raw_len)
+{
+	unsigned char	*raw;
+	unsigned int	c;
+	int				i;
+	int				k;
+
+	raw = malloc(raw_len);
+	png->data = malloc(raw_len + raw_len / PNG_STORED_MAX * 5 + 128);
+	if (!raw || !png->data)
+	{
+		free(raw);
+		return (NULL);
+	}
+	i = -1;
+	while (++i < WINDOW_HEIGHT)
+	{
+		raw[(size_t)i * (WINDOW_WIDTH * 3 + 1)] = 0;
+		image_pack_row(render, raw + (size_t)i * (WINDOW_WIDTH * 3 + 1) + 1,
+			i);
+	}
+	i = -1;
+	while (++i < 256)
+	{
+		c = (unsigned int)i;
+		k = -1;
+		while (++k < 8)
+			c = (c >> 1) ^ (0xEDB88320u & -(c & 1u));
+		png->crc_table[i] = c;
+	}
+	return (raw);
+}
+
+int	image_write_png(const char *path, t_render *render)
+{
+	t_png			png;
+	unsigned char	*raw;
+	size_t			raw_len;
+	size_t			start;
+	int				ok;
+
+	raw_len = (size_t)WINDOW_HEIGHT * (WINDOW_WIDTH * 3 + 1);
+	png.data = NULL;
+	raw = prepare_png(&png, render, raw_len);
+	if (!raw)
+	{
+		free(png.data);
+		return (print_error("Out of memory writing image"));
+	}
+	memcpy(png.data, "\x89PNG\r\n\x1a\n", 8);
+	png.len = 8;
+	start = begin_chunk(&png, "IHDR");
+	put_u32(png.data + png.len, WINDOW_WIDTH);
+	put_u32(png.data + png.len + 4, WINDOW_HEIGHT);
+	memcpy(png.data + png.len + 8, "\x08\x02\x00\x00\x00", 5);
+	png.len += 13;
+	end_chunk(&png, start);
+	start = begin_chunk(&png, "IDAT");
+	store_zlib(&png, raw, raw_len);
+	end_chunk(&png, start);
+	end_chunk(&png, begin_chunk(&png, "IEND"));
+	ok = image_write_file(path, png.data, png.len);
+	free(raw);
+	free(png.data);
+	return (ok);
+}
@@ -0,0 +1,210 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   obj_loader.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:21:07 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 11:21:07 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "parser.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*
+** Next line of the file into r->line, refilling the buffer as needed;
+** '\n' ends a line and is dropped. Returns 0 once the file is done
+** or a read failed (len < 0), 1 for a line, and 2 for a line that did
+** not fit: it is still read through to its end, and r->line keeps its
+** first OBJ_LINE_MAX - 1 characters.
+*/
+static int	read_line(t_obj_reader *r)
+{
+	int		i;
+	int		overlong;
+	char	c;
+
+	i = 0;
+	overlong = 0;
+	c = 0;
+	while (c != '\n')
+	{
+		if (r->pos == r->len)
+		{
+			r->len = read(r->fd, r->buf, OBJ_READ_SIZE);
+			r->pos = 0;
+			if (r->len < 0 || (r->len == 0 && i == 0))
+				return (0);
+			if (r->len == 0)
+				break ;
+		}
+		c = r->buf[r->pos++];
+		if (c != '\n' && i == OBJ_LINE_MAX - 1)
+			overlong = 1;
+		else if (c != '\n')
+			r->line[i++] = c;
+	}
+	r->line[i] = '\0';
+	return (1 + overlong);
+}
+
+/* v <x> <y> <z>: a vertex; a fourth (w) coordinate is ignored */
+static int	add_vertex(t_obj_reader *r, char *s)
+{
+	t_vertex	*v;
+	char		*end[3];
+
+	if (!scene_reserve_vertex(r->scene))
+		return (print_error("Out of memory"));
+	v = &r->scene->vertices[r->scene->vertex_count];
+	v->x = strtof(s, &end[0]);
+	v->y = strtof(end[0], &end[1]);
+	v->z = strtof(end[1], &end[2]);
+	if (end[0] == s || end[1] == end[0] || end[2] == end[1])
+		return (print_error("Invalid OBJ vertex"));
+	r->scene->vertex_count++;
+	return (1);
+}
+
+/*
+** Vertex index of the face corner at *s (i, i/t, i//n or i/t/n),
+** moved past it. Positive indices count from 1 within this file,
+** negative ones back from the last vertex read. Returns -1 when the
+** index is malformed or out of range.
+*/
+static int	corner_index(t_obj_reader *r, char **s)
+{
+	char	*end;
+	long	i;
+
+	i = strtol(*s, &end, 10);
+	if (end == *s || i == 0)
+		return (-1);
+	while (*end && *end != ' ' && *end != '\t' && *end != '\r')
+		end++;
+	*s = end;
+	if (i < 0)
+		i += r->scene->vertex_count;
+	else
+		i += r->first_vertex - 1;
+	if (i < r->first_vertex || i >= r->scene->vertex_count)
+		return (-1);
+	return ((int)i);
+}
+
+/* Append triangle tri, closed by corner index; index opens the next one */
+static int	add_triangle(t_obj_reader *r, t_triangle *tri, int index)
+{
+	if (!scene_reserve_triangle(r->scene))
+		return (print_error("Out of memory"));
+	tri->v[2] = index;
+	r->scene->triangles[r->scene->triangle_count++] = *tri;
+	tri->v[1] = index;
+	return (1);
+}
+
+/*
+** f <a> <b> <c> ...: polygons are fanned around their first corner
+** into (a, b, c), (a, c, d), ...
+*/
+static int	add_face(t_obj_reader *r, char *s)
+{
+	t_triangle	tri;
+	int			index;
+	int			n;
+
+	tri.mesh = r->mesh;
+	n = 0;
+	while (*s)
+	{
+		while (*s == ' ' || *s == '\t' || *s == '\r')
+			s++;
+		if (*s == '\0')
+			break ;
+		index = corner_index(r, &s);
+		if (index < 0)
+			return (print_error("Invalid OBJ face"));
+		if (n < 2)
+			tri.v[n] = index;
+		else if (!add_triangle(r, &tri, index))
+			return (0);
+		n++;
+	}
+	if (n < 3)
+		return (print_error("OBJ face needs at least 3 vertices"));
+	return (1);
+}
+
+/*
+** The line in r->line; only vertices and faces are kept. An overlong
+** line is skipped unless it is one of them, which cannot be cut short.
+*/
+static int	parse_obj_line(t_obj_reader *r, int overlong)
+{
+	char	kind;
+
+	kind = 0;
+	if ((r->line[0] == 'v' || r->line[0] == 'f')
+		&& (r->line[1] == ' ' || r->line[1] == '\t'))
+		kind = r->line[0];
+	if (kind && overlong)
+		return (print_error("OBJ line too long"));
+	if (kind == 'v')
+		return (add_vertex(r, r->line + 2));
+	if (kind == 'f')
+		return (add_face(r, r->line + 1));
+	return (1);
+}
+
+/* Every line of the file */
+static int	read_lines(t_obj_reader *r)
+{
+	int	status;
+
+	status = read_line(r);
+	while (status > 0)
+	{
+		if (!parse_obj_line(r, status == 2))
+			return (0);
+		status = read_line(r);
+	}
+	if (r->len < 0)
+		return (print_error("Cannot read OBJ file"));
+	return (1);
+}
+
+/*
+** Stream an OBJ file into scene: its vertices are appended to the
+** vertex buffer and its faces, triangulated, to the triangle list
+** as part of mesh. Normals, texture coordinates, groups and materials
+** are skipped.
+*/
+int	obj_load(const char *path, t_scene *scene, int mesh)
+{
+	t_obj_reader	*r;
+	int				ok;
+
+	r = malloc(sizeof(t_obj_reader));
+	if (!r)
+		return (print_error("Out of memory"));
+	r->fd = open(path, O_RDONLY);
+	if (r->fd < 0)
+	{
+		free(r);
+		return (print_error("Cannot open OBJ file"));
+	}
+	r->len = 0;
+	r->pos = 0;
+	r->scene = scene;
+	r->first_vertex = scene->vertex_count;
+	r->mesh = mesh;
+	ok = read_lines(r);
+	close(r->fd);
+	free(r);
+	return (ok);
+}
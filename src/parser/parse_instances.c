@@ -0,0 +1,206 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parse_instances.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:12:40 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 10:12:40 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "parser.h"
+#include <math.h>
+#include <string.h>
+
+/* Length of the group name at str: letters, digits and '_' */
+static int	name_length(const char *str)
+{
+	int	len;
+
+	len = 0;
+	while ((str[len] >= 'a' && str[len] <= 'z')
+		|| (str[len] >= 'A' && str[len] <= 'Z')
+		|| (str[len] >= '0' && str[len] <= '9') || str[len] == '_')
+		len++;
+	return (len);
+}
+
+/* Index of the group called name (len characters), or -1 */
+static int	find_group(t_scene *scene, const char *name, int len)
+{
+	int	i;
+
+	i = 0;
+	while (i < scene->group_count)
+	{
+		if ((int)strlen(scene->groups[i].name) == len
+			&& strncmp(scene->groups[i].name, name, len) == 0)
+			return (i);
+		i++;
+	}
+	return (-1);
+}
+
+/*
+** Scene holding the primitives of the group called name, created
+** empty on first use. Returns NULL when out of memory.
+*/
+static t_scene	*group_objects(t_scene *scene, const char *name, int len)
+{
+	t_group	*group;
+	int		index;
+
+	index = find_group(scene, name, len);
+	if (index >= 0)
+		return (scene->groups[index].objects);
+	if (!scene_reserve_group(scene))
+		return (NULL);
+	group = &scene->groups[scene->group_count];
+	group->objects = init_scene();
+	if (!group->objects)
+		return (NULL);
+	memcpy(group->name, name, len);
+	group->name[len] = '\0';
+	scene->group_count++;
+	return (group->objects);
+}
+
+/*
+** Parse one member of a group.
+** Format: gr <name> sp ..., gr <name> cy ... or gr <name> mh ...
+** The rest of the line is an ordinary sphere, cylinder or mesh in
+** group space. Planes have no bounds for a bottom-level BVH and
+** cannot be grouped.
+*/
+int	parse_group(char *line, t_scene *scene, const char *scene_file)
+{
+	char	*token;
+	t_scene	*objects;
+	int		len;
+
+	token = line + 3;
+	while (*token == ' ')
+		token++;
+	len = name_length(token);
+	if (len == 0 || len >= GROUP_NAME_MAX || token[len] != ' ')
+		return (print_error("Invalid group name"));
+	objects = group_objects(scene, token, len);
+	if (!objects)
+		return (print_error("Out of memory"));
+	token += len;
+	while (*token == ' ')
+		token++;
+	if (token[0] == 's' && token[1] == 'p' && token[2] == ' ')
+		return (parse_sphere(token, objects));
+	if (token[0] == 'c' && token[1] == 'y' && token[2] == ' ')
+		return (parse_cylinder(token, objects));
+	if (token[0] == 'm' && token[1] == 'h' && token[2] == ' ')
+		return (parse_mesh(token, objects, scene_file));
+	return (print_error("Groups hold only spheres, cylinders and meshes"));
+}
+
+/* v turned by angle radians about coordinate axis (0 = x, 1 = y, 2 = z) */
+static t_vec3	rotate_about(t_vec3 v, int axis, double angle)
+{
+	double	c;
+	double	s;
+
+	c = cos(angle);
+	s = sin(angle);
+	if (axis == 0)
+		return ((t_vec3){v.x, c * v.y - s * v.z, s * v.y + c * v.z});
+	if (axis == 1)
+		return ((t_vec3){c * v.x + s * v.z, v.y, c * v.z - s * v.x});
+	return ((t_vec3){c * v.x - s * v.y, s * v.x + c * v.y, v.z});
+}
+
+/*
+** Instance basis from rotation angles in degrees: each unit axis is
+** turned about x, then y, then z. Angles must lie in [-360, 360].
+*/
+static int	set_rotation(t_instance *instance, t_vec3 degrees)
+{
+	t_vec3	*axis;
+	int		i;
+
+	if (!in_range(degrees.x, -360, 360) || !in_range(degrees.y, -360, 360)
+		|| !in_range(degrees.z, -360, 360))
+		return (0);
+	i = 0;
+	while (i < 3)
+	{
+		axis = &instance->axis[i];
+		*axis = (t_vec3){i == 0, i == 1, i == 2};
+		*axis = rotate_about(*axis, 0, degrees.x * M_PI / 180.0);
+		*axis = rotate_about(*axis, 1, degrees.y * M_PI / 180.0);
+		*axis = rotate_about(*axis, 2, degrees.z * M_PI / 180.0);
+		i++;
+	}
+	return (1);
+}
+
+/*
+** Parse an instance of a group defined earlier in the file.
+** Format: in <name> <x,y,z> <rx,ry,rz> <scale>
+** Rotation is in degrees; scale is uniform and positive, so spheres
+** stay spheres and hit distances scale by the same factor.
+*/
+int	parse_instance(char *line, t_scene *scene)
+{
+	char		*token;
+	t_instance	*instance;
+	t_vec3		degrees;
+
+	if (!scene_reserve_instance(scene))
+		return (print_error("Out of memory"));
+	instance = &scene->instances[scene->instance_count];
+	token = line + 3;
+	while (*token == ' ')
+		token++;
+	instance->group = find_group(scene, token, name_length(token));
+	if (name_length(token) == 0 || instance->group < 0)
+		return (print_error("Instance of an undefined group"));
+	token = skip_to_next_token(token);
+	if (!parse_vector(token, &instance->position))
+		return (print_error("Invalid instance position"));
+	token = skip_to_next_token(token);
+	if (!parse_vector(token, &degrees) || !set_rotation(instance, degrees))
+		return (print_error("Instance rotation must be in [-360, 360]"));
+	instance->scale = ft_atof(skip_to_next_token(token));
+	if (instance->scale <= 0)
+		return (print_error("Instance scale must be positive"));
+	scene->instance_count++;
+	return (1);
+}
+
+/*
+** Parse a mesh outside any group.
+** Format: mh <file.obj> <R,G,B>
+** The mesh goes into an unnamed group of its own, placed once as the
+** file has it, so like any group it gets a BVH of its own under the
+** scene BVH. gr <name> mh ... puts a mesh in a group for instancing.
+*/
+int	parse_placed_mesh(char *line, t_scene *scene, const char *scene_file)
+{
+	t_scene		*objects;
+	t_instance	*instance;
+
+	if (!scene_reserve_group(scene) || !scene_reserve_instance(scene))
+		return (print_error("Out of memory"));
+	objects = init_scene();
+	if (!objects)
+		return (print_error("Out of memory"));
+	scene->groups[scene->group_count].objects = objects;
+	instance = &scene->instances[scene->instance_count];
+	instance->group = scene->group_count++;
+	instance->position = (t_vec3){0, 0, 0};
+	set_rotation(instance, (t_vec3){0, 0, 0});
+	instance->scale = 1;
+	if (!parse_mesh(line, objects, scene_file))
+		return (0);
+	scene->instance_count++;
+	return (1);
+}
@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parse_mesh.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:21:07 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 11:21:07 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "parser.h"
+#include <string.h>
+
+/*
+** Copy the path token at token into path. A relative path is taken
+** relative to the directory of scene_file, so a scene finds its meshes
+** from any working directory. 0 if empty or too long.
+*/
+static int	copy_path(const char *token, const char *scene_file, char *path)
+{
+	const char	*slash;
+	int			dir_len;
+	int			len;
+
+	dir_len = 0;
+	slash = strrchr(scene_file, '/');
+	if (token[0] != '/' && slash)
+		dir_len = slash - scene_file + 1;
+	len = 0;
+	while (token[len] && token[len] != ' ' && token[len] != '\t')
+		len++;
+	if (len == 0 || dir_len + len >= MESH_PATH_MAX)
+		return (0);
+	memcpy(path, scene_file, dir_len);
+	memcpy(path + dir_len, token, len);
+	path[dir_len + len] = '\0';
+	return (1);
+}
+
+/*
+** Parse a triangle mesh into scene.
+** Format: mh <file.obj> <R,G,B>
+** A relative path starts from the scene file's directory. The whole
+** mesh gets one color; its triangles go to scene's triangle list and
+** are covered by the BVH built over that scene.
+*/
+int	parse_mesh(char *line, t_scene *scene, const char *scene_file)
+{
+	char	path[MESH_PATH_MAX];
+	char	*token;
+	t_mesh	*mesh;
+	int		first_vertex;
+
+	if (!scene_reserve_mesh(scene))
+		return (print_error("Out of memory"));
+	mesh = &scene->meshes[scene->mesh_count];
+	token = line + 3;
+	while (*token == ' ')
+		token++;
+	if (!copy_path(token, scene_file, path))
+		return (print_error("Invalid mesh file path"));
+	if (!parse_color(skip_to_next_token(token), &mesh->color))
+		return (0);
+	mesh->first_triangle = scene->triangle_count;
+	first_vertex = scene->vertex_count;
+	if (!obj_load(path, scene, scene->mesh_count))
+		return (0);
+	mesh->triangle_count = scene->triangle_count - mesh->first_triangle;
+	mesh->vertex_count = scene->vertex_count - first_vertex;
+	if (mesh->triangle_count == 0)
+		return (print_error("Mesh file has no faces"));
+	scene->mesh_count++;
+	return (1);
+}
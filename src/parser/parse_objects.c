@@ -18,7 +18,7 @@
 ** Helper function to skip current token and advance to next.
 ** Skips non-space characters, then skips spaces.
 */
-static char	*skip_to_next_token(char *token)
+char	*skip_to_next_token(char *token)
 {
 	while (*token && *token != ' ')
 		token++;
@@ -37,8 +37,8 @@ int	parse_sphere(char *line, t_scene *scene)
 	char		*token;
 	t_sphere	*sphere;
 
-	if (scene->sphere_count >= 100)
-		return (print_error("Too many spheres"));
+	if (!scene_reserve_sphere(scene))
+		return (print_error("Out of memory"));
 	sphere = &scene->spheres[scene->sphere_count];
 	token = line + 3;
 	while (*token == ' ')
@@ -54,6 +54,7 @@ int	parse_sphere(char *line, t_scene *scene)
 	token = skip_to_next_token(token);
 	if (!parse_color(token, &sphere->color))
 		return (0);
+	scene_sync_sphere(scene, scene->sphere_count);
 	scene->sphere_count++;
 	return (1);
 }
@@ -68,8 +69,8 @@ int	parse_plane(char *line, t_scene *scene)
 	char		*token;
 	t_plane		*plane;
 
-	if (scene->plane_count >= 100)
-		return (print_error("Too many planes"));
+	if (!scene_reserve_plane(scene))
+		return (print_error("Out of memory"));
 	plane = &scene->planes[scene->plane_count];
 	token = line + 3;
 	while (*token == ' ')
@@ -83,6 +84,7 @@ int	parse_plane(char *line, t_scene *scene)
 	token = skip_to_next_token(token);
 	if (!parse_color(token, &plane->color))
 		return (0);
+	scene_sync_plane(scene, scene->plane_count);
 	scene->plane_count++;
 	return (1);
 }
@@ -116,8 +118,8 @@ int	parse_cylinder(char *line, t_scene *scene)
 	char		*token;
 	t_cylinder	*cylinder;
 
-	if (scene->cylinder_count >= 100)
-		return (print_error("Too many cylinders"));
+	if (!scene_reserve_cylinder(scene))
+		return (print_error("Out of memory"));
 	cylinder = &scene->cylinders[scene->cylinder_count];
 	token = line + 3;
 	while (*token == ' ')
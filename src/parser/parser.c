@@ -12,7 +12,6 @@
 
 #include "minirt.h"
 #include "parser.h"
-#include "spatial.h"
 #include <fcntl.h>
 #include <unistd.h>
 #include <stdlib.h>
@@ -51,8 +50,9 @@ static char	*read_line(int fd)
 ** Parse single line from scene file.
 ** Identifies element type by prefix and calls appropriate parser.
 ** Returns 1 on success, 0 on error. Skips empty lines and comments.
+** filename is the scene file, against which mesh paths are resolved.
 */
-static int	parse_line(char *line, t_scene *scene)
+static int	parse_line(char *line, t_scene *scene, const char *filename)
 {
 	while (*line == ' ' || *line == '\t')
 		line++;
@@ -70,12 +70,19 @@ static int	parse_line(char *line, t_scene *scene)
 		return (parse_plane(line, scene));
 	else if (line[0] == 'c' && line[1] == 'y' && line[2] == ' ')
 		return (parse_cylinder(line, scene));
+	else if (line[0] == 'm' && line[1] == 'h' && line[2] == ' ')
+		return (parse_placed_mesh(line, scene, filename));
+	else if (line[0] == 'g' && line[1] == 'r' && line[2] == ' ')
+		return (parse_group(line, scene, filename));
+	else if (line[0] == 'i' && line[1] == 'n' && line[2] == ' ')
+		return (parse_instance(line, scene));
 	return (print_error("Invalid element identifier"));
 }
 
 /*
 ** Parse scene description file and populate scene structure.
 ** Opens file, reads line by line, and dispatches to element parsers.
+** The BVH is built separately by the caller (scene_build_bvh).
 ** Returns 1 on success, 0 on error.
 */
 int	parse_scene(const char *filename, t_scene *scene)
@@ -91,17 +98,13 @@ int	parse_scene(const char *filename, t_scene *scene)
 	line = read_line(fd);
 	while (success && line != NULL)
 	{
-		success = parse_line(line, scene);
+		success = parse_line(line, scene, filename);
 		free(line);
 		line = read_line(fd);
 	}
 	close(fd);
 	if (success)
-	{
 		success = validate_scene(scene);
-		if (success)
-			scene_build_bvh(scene);
-	}
 	return (success);
 }
 
@@ -118,7 +121,7 @@ int	validate_scene(t_scene *scene)
 	if (!scene->has_light)
 		return (print_error("Missing light (L)"));
 	if (scene->sphere_count == 0 && scene->plane_count == 0
-		&& scene->cylinder_count == 0)
+		&& scene->cylinder_count == 0 && scene->instance_count == 0)
 		return (print_error("No objects in scene"));
 	return (1);
 }
@@ -18,12 +18,12 @@
 /* Helper structure for cylinder intersection calculations */
 typedef struct s_cyl_calc
 {
-	double	a;
-	double	b;
-	double	c;
-	double	discriminant;
-	double	t;
-	double	m;
+	t_real	a;
+	t_real	half_b;
+	t_real	c;
+	t_real	discriminant;
+	t_real	t;
+	t_real	m;
 }	t_cyl_calc;
 
 /*
@@ -35,10 +35,10 @@ static int	calculate_cylinder_intersection(t_ray *ray, t_cylinder *cyl, \
 		t_cyl_calc *calc)
 {
 	t_vec3	oc;
-	double	dir_dot_axis;
-	double	oc_dot_axis;
-	double	dir_dot_dir;
-	double	oc_dot_oc;
+	t_real	dir_dot_axis;
+	t_real	oc_dot_axis;
+	t_real	dir_dot_dir;
+	t_real	oc_dot_oc;
 
 	oc = vec3_subtract(ray->origin, cyl->center);
 	dir_dot_axis = vec3_dot(ray->direction, cyl->axis);
@@ -46,49 +46,60 @@ static int	calculate_cylinder_intersection(t_ray *ray, t_cylinder *cyl, \
 	dir_dot_dir = vec3_dot(ray->direction, ray->direction);
 	oc_dot_oc = vec3_dot(oc, oc);
 	calc->a = dir_dot_dir - dir_dot_axis * dir_dot_axis;
-	calc->b = 2.0 * (vec3_dot(ray->direction, oc) - \
-		dir_dot_axis * oc_dot_axis);
+	calc->half_b = vec3_dot(ray->direction, oc) - \
+		dir_dot_axis * oc_dot_axis;
 	calc->c = oc_dot_oc - oc_dot_axis * oc_dot_axis - cyl->radius_squared;
-	calc->discriminant = calc->b * calc->b - 4 * calc->a * calc->c;
-	if (calc->discriminant < 0 || calc->a < EPSILON)
+	calc->discriminant = calc->half_b * calc->half_b - calc->a * calc->c;
+	if (calc->discriminant < 0 || calc->a < REAL_EPSILON)
 		return (0);
-	calc->t = (-calc->b - sqrt(calc->discriminant)) / (2.0 * calc->a);
-	if (calc->t < 0.001)
-		calc->t = (-calc->b + sqrt(calc->discriminant)) / (2.0 * calc->a);
+	calc->t = quadratic_nearest_root(calc->a, calc->half_b, calc->c,
+			calc->discriminant);
 	calc->m = dir_dot_axis * calc->t + oc_dot_axis;
 	return (1);
 }
 
 /*
-** Check ray intersection with cylinder cap (top or bottom disc).
-** Returns 1 if hit and updates hit info, 0 otherwise.
+** Distance along ray to the cap disc at cap_m on the axis.
+** Returns -1 if the ray is parallel to the cap or misses the disc.
 */
-int	intersect_cylinder_cap(t_ray *ray, t_cylinder *cyl, t_hit *hit, \
-		double cap_m)
+static t_real	cylinder_cap_t(t_ray *ray, t_cylinder *cyl, t_real cap_m)
 {
 	t_vec3	cap_center;
-	double	denom;
-	double	t;
+	t_real	denom;
+	t_real	t;
 	t_vec3	p;
-	double	dist_sq;
+	t_real	dist_sq;
 
 	denom = vec3_dot(ray->direction, cyl->axis);
-	if (fabs(denom) < EPSILON)
-		return (0);
+	if (REAL_FABS(denom) < REAL_EPSILON)
+		return (-1);
 	cap_center = vec3_add(cyl->center, vec3_multiply(cyl->axis, cap_m));
 	t = vec3_dot(vec3_subtract(cap_center, ray->origin), cyl->axis) / denom;
-	if (t < 0.001 || t > hit->distance)
-		return (0);
 	p = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
 	dist_sq = vec3_dot(vec3_subtract(p, cap_center), \
 		vec3_subtract(p, cap_center));
 	if (dist_sq > cyl->radius_squared)
+		return (-1);
+	return (t);
+}
+
+/*
+** Check ray intersection with cylinder cap (top or bottom disc).
+** Returns 1 if hit and updates hit info, 0 otherwise.
+*/
+int	intersect_cylinder_cap(t_ray *ray, t_cylinder *cyl, t_hit *hit, \
+		t_real cap_m)
+{
+	t_real	t;
+
+	t = cylinder_cap_t(ray, cyl, cap_m);
+	if (t < RAY_T_MIN || t > hit->distance)
 		return (0);
 	hit->distance = t;
-	hit->point = p;
+	hit->point = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
 	hit->normal = cyl->axis;
 	if (vec3_dot(ray->direction, hit->normal) > 0)
-		hit->normal = vec3_multiply(hit->normal, -1.0);
+		hit->normal = vec3_multiply(hit->normal, -1);
 	hit->color = cyl->color;
 	return (1);
 }
@@ -105,7 +116,7 @@ int	intersect_cylinder_body(t_ray *ray, t_cylinder *cyl, t_hit *hit)
 
 	if (!calculate_cylinder_intersection(ray, cyl, &calc))
 		return (0);
-	if (calc.t < 0.001 || calc.t > hit->distance)
+	if (calc.t < RAY_T_MIN || calc.t > hit->distance)
 		return (0);
 	hit_point = vec3_add(ray->origin, vec3_multiply(ray->direction, calc.t));
 	if (calc.m < -cyl->half_height || calc.m > cyl->half_height)
@@ -151,3 +162,24 @@ int	intersect_cylinder(t_ray *ray, t_cylinder *cylinder, t_hit *hit)
 	}
 	return (hit_found);
 }
+
+/*
+** Any-hit form of intersect_cylinder for shadow rays: 1 if the body
+** or a cap is hit within [RAY_T_MIN, max_distance]. The same roots as
+** the closest-hit tests, without filling a hit record.
+*/
+int	cylinder_occludes(t_ray *ray, t_cylinder *cyl, t_real max_distance)
+{
+	t_cyl_calc	calc;
+	t_real		t;
+
+	if (calculate_cylinder_intersection(ray, cyl, &calc)
+		&& !(calc.t < RAY_T_MIN || calc.t > max_distance)
+		&& !(calc.m < -cyl->half_height || calc.m > cyl->half_height))
+		return (1);
+	t = cylinder_cap_t(ray, cyl, cyl->half_height);
+	if (!(t < RAY_T_MIN || t > max_distance))
+		return (1);
+	t = cylinder_cap_t(ray, cyl, -cyl->half_height);
+	return (!(t < RAY_T_MIN || t > max_distance));
+}
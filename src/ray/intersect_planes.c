@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   intersect_planes.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/13 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/13 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Unbounded primitives. Planes have no useful bounding box, so they
+** stay out of the BVH and are tested here in a flat loop against
+** the plane equation dot(normal, x) = d.
+*/
+
+#include "minirt.h"
+#include "ray.h"
+
+/* Recompute the plane offset d after the plane is parsed or moved */
+void	scene_sync_plane(t_scene *scene, int index)
+{
+	t_plane	*plane;
+
+	plane = &scene->planes[index];
+	plane->d = vec3_dot(plane->normal, plane->point);
+}
+
+/* intersect_plane's distance; -1 when the ray runs parallel */
+static t_real	plane_distance(t_plane *plane, t_ray *ray)
+{
+	t_real	denom;
+
+	denom = vec3_dot(plane->normal, ray->direction);
+	if (REAL_FABS(denom) < REAL_EPSILON)
+		return (-1);
+	return ((plane->d - vec3_dot(plane->normal, ray->origin)) / denom);
+}
+
+/*
+** Closest plane hit no farther than hit->distance, with
+** intersect_plane's test in plane order. Only the winner's hit
+** record is filled in.
+*/
+int	intersect_planes(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	t_real	t;
+	int		i;
+	int		found;
+
+	found = -1;
+	i = 0;
+	while (i < scene->plane_count)
+	{
+		t = plane_distance(&scene->planes[i], ray);
+		if (!(t < RAY_T_MIN || t > hit->distance))
+		{
+			hit->distance = t;
+			found = i;
+		}
+		i++;
+	}
+	if (found < 0)
+		return (0);
+	plane_set_hit(ray, &scene->planes[found], hit->distance, hit);
+	return (1);
+}
+
+/* Any-hit form for shadow rays */
+int	planes_occlude(t_scene *scene, t_ray *ray, t_real max_distance)
+{
+	t_real	t;
+	int		i;
+
+	i = 0;
+	while (i < scene->plane_count)
+	{
+		t = plane_distance(&scene->planes[i], ray);
+		if (!(t < RAY_T_MIN || t > max_distance))
+			return (1);
+		i++;
+	}
+	return (0);
+}
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   intersect_spheres.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+
+/*
+** SIMD sphere tests over the SoA arrays: one sphere per lane, as many
+** lanes as fit a 256-bit vector (4 doubles or 8 floats). The lane
+** arithmetic is calculate_sphere_t step by step, and lanes are
+** reduced in sphere order, so results match the per-sphere loop.
+*/
+
+#define SIMD_LANES (32 / (int)sizeof(t_real))
+
+#include "minirt.h"
+#include "simd_real.h"
+#include <string.h>
+
+void	scene_sync_sphere(t_scene *scene, int index)
+{
+	t_sphere_soa	*soa;
+	t_sphere		*sphere;
+
+	soa = &scene->sphere_soa;
+	sphere = &scene->spheres[index];
+	soa->cx[index] = sphere->center.x;
+	soa->cy[index] = sphere->center.y;
+	soa->cz[index] = sphere->center.z;
+	soa->r2[index] = sphere->radius_squared;
+}
+
+/* Unaligned load: the scene is malloc'd, so no 32-byte alignment */
+static t_vreal	soa_load(const t_real *src)
+{
+	t_vreal	v;
+
+	memcpy(&v, src, sizeof(v));
+	return (v);
+}
+
+/*
+** Distances from ray to spheres [i, i + SIMD_LANES); -1 marks misses.
+** a is dot(direction, direction), shared by every sphere. Most blocks
+** miss entirely, so the root is only solved when some lane can hit.
+*/
+static t_vreal	sphere_block(t_sphere_soa *soa, int i, t_ray *ray, t_real a)
+{
+	t_vreal	oc[3];
+	t_vreal	half_b;
+	t_vreal	proj;
+	t_vreal	disc;
+
+	oc[0] = ray->origin.x - soa_load(soa->cx + i);
+	oc[1] = ray->origin.y - soa_load(soa->cy + i);
+	oc[2] = ray->origin.z - soa_load(soa->cz + i);
+	half_b = oc[0] * ray->direction.x + oc[1] * ray->direction.y
+		+ oc[2] * ray->direction.z;
+	proj = half_b / a;
+	disc = a * (soa_load(soa->r2 + i) - simd_len2(
+				oc[0] - ray->direction.x * proj,
+				oc[1] - ray->direction.y * proj,
+				oc[2] - ray->direction.z * proj));
+	if (!simd_any(~(t_vmask)(disc < 0)))
+		return (simd_splat(-1));
+	return (simd_nearest_root(simd_splat(a), half_b,
+			simd_len2(oc[0], oc[1], oc[2]) - soa_load(soa->r2 + i), disc));
+}
+
+/*
+** Closest sphere hit no farther than hit->distance. Lanes are taken
+** in sphere order with intersect_sphere's test, so ties resolve like
+** the scalar loop. Only the winner's t_sphere record is read.
+*/
+int	intersect_spheres(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	t_vreal	t;
+	t_real	a;
+	int		i;
+	int		lane;
+	int		found;
+
+	a = vec3_dot(ray->direction, ray->direction);
+	found = -1;
+	i = 0;
+	while (i < scene->sphere_count)
+	{
+		t = sphere_block(&scene->sphere_soa, i, ray, a);
+		lane = -1;
+		while (++lane < SIMD_LANES && i + lane < scene->sphere_count)
+		{
+			if (!(t[lane] < RAY_T_MIN || t[lane] > hit->distance))
+			{
+				hit->distance = t[lane];
+				found = i + lane;
+			}
+		}
+		i += SIMD_LANES;
+	}
+	if (found < 0)
+		return (0);
+	sphere_set_hit(ray, &scene->spheres[found], hit->distance, hit);
+	return (1);
+}
+
+/* Any-hit form for shadow rays: stops at the first blocking block */
+int	spheres_occlude(t_scene *scene, t_ray *ray, t_real max_distance)
+{
+	t_vreal	t;
+	t_vmask	blocked;
+	t_real	a;
+	int		i;
+	int		lane;
+
+	a = vec3_dot(ray->direction, ray->direction);
+	i = 0;
+	while (i < scene->sphere_count)
+	{
+		t = sphere_block(&scene->sphere_soa, i, ray, a);
+		blocked = ~(t_vmask)(t < RAY_T_MIN) & ~(t_vmask)(t > max_distance);
+		lane = -1;
+		while (++lane < SIMD_LANES && i + lane < scene->sphere_count)
+		{
+			if (blocked[lane])
+				return (1);
+		}
+		i += SIMD_LANES;
+	}
+	return (0);
+}
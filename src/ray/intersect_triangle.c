@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   intersect_triangle.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:05:31 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 11:05:31 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "ray.h"
+
+/*
+** Vertex v in ray space: relative to the origin, permuted by k and
+** sheared so the ray runs along +z. out[0], out[1] are the 2D
+** position the ray sees and out[2] the scaled depth.
+*/
+static void	to_ray_space(const t_vertex *v, const t_ray *ray, t_real out[3])
+{
+	t_real	p[3];
+
+	p[0] = v->x - ray->origin.x;
+	p[1] = v->y - ray->origin.y;
+	p[2] = v->z - ray->origin.z;
+	out[0] = p[ray->k[0]] - ray->shear.x * p[ray->k[2]];
+	out[1] = p[ray->k[1]] - ray->shear.y * p[ray->k[2]];
+	out[2] = ray->shear.z * p[ray->k[2]];
+}
+
+/*
+** Distance to triangle tri, or -1 on a miss. Watertight test: in ray
+** space the ray is the z axis, so the hit is decided by the signs of
+** the three 2D edge functions, which come out exactly opposite for
+** the two triangles sharing an edge and let no ray slip between them.
+** The edge functions are always evaluated in double (the paper's
+** fallback for exact zeros in single precision). Both sides are hit.
+*/
+static t_real	triangle_distance(const t_ray *ray, const t_vertex *vertices,
+		const t_triangle *tri)
+{
+	t_real	a[3];
+	t_real	b[3];
+	t_real	c[3];
+	double	e[3];
+	double	det;
+
+	to_ray_space(&vertices[tri->v[0]], ray, a);
+	to_ray_space(&vertices[tri->v[1]], ray, b);
+	to_ray_space(&vertices[tri->v[2]], ray, c);
+	e[0] = (double)c[0] * b[1] - (double)c[1] * b[0];
+	e[1] = (double)a[0] * c[1] - (double)a[1] * c[0];
+	e[2] = (double)b[0] * a[1] - (double)b[1] * a[0];
+	if ((e[0] < 0 || e[1] < 0 || e[2] < 0)
+		&& (e[0] > 0 || e[1] > 0 || e[2] > 0))
+		return (-1);
+	det = e[0] + e[1] + e[2];
+	if (det == 0)
+		return (-1);
+	return ((e[0] * a[2] + e[1] * b[2] + e[2] * c[2]) / det);
+}
+
+/* Unit geometric normal of tri, turned toward the ray's origin */
+static t_vec3	triangle_normal(const t_ray *ray, const t_vertex *vertices,
+		const t_triangle *tri)
+{
+	const t_vertex	*v[3];
+	t_vec3			n;
+
+	v[0] = &vertices[tri->v[0]];
+	v[1] = &vertices[tri->v[1]];
+	v[2] = &vertices[tri->v[2]];
+	n = vec3_cross((t_vec3){v[1]->x - v[0]->x, v[1]->y - v[0]->y,
+			v[1]->z - v[0]->z}, (t_vec3){v[2]->x - v[0]->x,
+			v[2]->y - v[0]->y, v[2]->z - v[0]->z});
+	n = vec3_normalize(n);
+	if (vec3_dot(n, ray->direction) > 0)
+		n = vec3_multiply(n, -1);
+	return (n);
+}
+
+/*
+** Ray against mesh triangle index of scene. The ray must have been
+** through ray_prepare, which holds for every BVH walk.
+** Returns 1 if hit and closer than current hit->distance, 0 otherwise.
+*/
+int	intersect_triangle(t_ray *ray, t_scene *scene, int index, t_hit *hit)
+{
+	t_triangle	*tri;
+	t_real		t;
+
+	tri = &scene->triangles[index];
+	t = triangle_distance(ray, scene->vertices, tri);
+	if (t < RAY_T_MIN || t > hit->distance)
+		return (0);
+	hit->distance = t;
+	hit->point = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
+	hit->normal = triangle_normal(ray, scene->vertices, tri);
+	hit->color = scene->meshes[tri->mesh].color;
+	return (1);
+}
+
+/* Any-hit form of intersect_triangle: hit within [RAY_T_MIN, max] */
+int	triangle_occludes(t_ray *ray, t_scene *scene, int index,
+		t_real max_distance)
+{
+	t_real	t;
+
+	t = triangle_distance(ray, scene->vertices, &scene->triangles[index]);
+	return (!(t < RAY_T_MIN || t > max_distance));
+}
@@ -16,28 +16,67 @@
 #include <math.h>
 
 /*
-** Calculate ray-sphere intersection distance using quadratic formula.
-** Solves: ||ray.origin + t*ray.direction - sphere.center||² = radius²
-** Returns closest positive t value, or -1 if no intersection.
+** Nearest root >= RAY_T_MIN of a t^2 + 2 half_b t + c = 0, or the far
+** root if the near one is behind the origin (caller rejects it).
+** Uses q = -(half_b + sign(half_b) sqrt(disc)), roots c / q and q / a,
+** which avoids the cancellation of (-b - sqrt(disc)) for near hits
+** such as shadow rays leaving a surface. Returns -1 on no real root.
 */
-static double	calculate_sphere_t(t_vec3 oc, t_ray *ray, double radius_squared)
+t_real	quadratic_nearest_root(t_real a, t_real half_b, t_real c,
+		t_real discriminant)
 {
-	double	a;
-	double	b;
-	double	c;
-	double	discriminant;
-	double	t;
+	t_real	q;
+	t_real	t0;
+	t_real	t1;
 
-	a = vec3_dot(ray->direction, ray->direction);
-	b = 2.0 * vec3_dot(oc, ray->direction);
-	c = vec3_dot(oc, oc) - radius_squared;
-	discriminant = b * b - 4 * a * c;
 	if (discriminant < 0)
 		return (-1);
-	t = (-b - sqrt(discriminant)) / (2.0 * a);
-	if (t < 0.001)
-		t = (-b + sqrt(discriminant)) / (2.0 * a);
-	return (t);
+	q = -half_b - REAL_COPYSIGN(REAL_SQRT(discriminant), half_b);
+	if (q == 0)
+		return (-1);
+	t0 = c / q;
+	t1 = q / a;
+	if (t0 > t1)
+	{
+		q = t0;
+		t0 = t1;
+		t1 = q;
+	}
+	if (t0 < RAY_T_MIN)
+		return (t1);
+	return (t0);
+}
+
+/*
+** Ray-sphere quadratic with ||oc + t*dir||^2 = r^2.
+** The discriminant is computed as a * (r^2 - |l|^2), with l the part
+** of oc perpendicular to the ray, instead of h^2 - a*c: the latter
+** subtracts two large nearly equal terms for distant spheres and
+** falls apart in single precision.
+*/
+static t_real	calculate_sphere_t(t_vec3 oc, t_ray *ray, t_real radius_squared)
+{
+	t_real	a;
+	t_real	half_b;
+	t_vec3	l;
+
+	a = vec3_dot(ray->direction, ray->direction);
+	half_b = vec3_dot(oc, ray->direction);
+	l = vec3_subtract(oc, vec3_multiply(ray->direction, half_b / a));
+	return (quadratic_nearest_root(a, half_b,
+			vec3_dot(oc, oc) - radius_squared,
+			a * (radius_squared - vec3_dot(l, l))));
+}
+
+/*
+** Fill hit for a ray hitting sphere at distance t.
+*/
+void	sphere_set_hit(t_ray *ray, t_sphere *sphere, t_real t, t_hit *hit)
+{
+	hit->distance = t;
+	hit->point = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
+	hit->normal = vec3_normalize(vec3_subtract(hit->point, sphere->center));
+	hit->color = sphere->color;
 }
 
 /*
@@ -48,42 +87,58 @@ static double	calculate_sphere_t(t_vec3 oc, t_ray *ray, double radius_squared)
 int	intersect_sphere(t_ray *ray, t_sphere *sphere, t_hit *hit)
 {
 	t_vec3	oc;
-	double	t;
+	t_real	t;
 
 	oc = vec3_subtract(ray->origin, sphere->center);
 	t = calculate_sphere_t(oc, ray, sphere->radius_squared);
-	if (t < 0.001 || t > hit->distance)
+	if (t < RAY_T_MIN || t > hit->distance)
 		return (0);
+	sphere_set_hit(ray, sphere, t, hit);
+	return (1);
+}
+
+/*
+** Any-hit form of intersect_sphere for shadow rays: 1 if the sphere
+** is hit within [RAY_T_MIN, max_distance], no hit record is filled.
+*/
+int	sphere_occludes(t_ray *ray, t_sphere *sphere, t_real max_distance)
+{
+	t_real	t;
+
+	t = calculate_sphere_t(vec3_subtract(ray->origin, sphere->center), ray,
+			sphere->radius_squared);
+	return (!(t < RAY_T_MIN || t > max_distance));
+}
+
+/*
+** Fill hit for a plane hit at distance t; the normal faces the ray.
+*/
+void	plane_set_hit(t_ray *ray, t_plane *plane, t_real t, t_hit *hit)
+{
 	hit->distance = t;
 	hit->point = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
-	hit->normal = vec3_normalize(vec3_subtract(hit->point, sphere->center));
-	hit->color = sphere->color;
-	return (1);
+	hit->normal = plane->normal;
+	if (vec3_dot(ray->direction, hit->normal) > 0)
+		hit->normal = vec3_multiply(hit->normal, -1);
+	hit->color = plane->color;
 }
 
 /*
 ** Test ray-plane intersection using plane equation.
-** Plane equation: dot(point - plane.point, plane.normal) = 0
+** Plane equation: dot(plane.normal, x) = plane.d
 ** Returns 1 if hit and closer than current hit->distance, 0 otherwise.
 */
 int	intersect_plane(t_ray *ray, t_plane *plane, t_hit *hit)
 {
-	double	denom;
-	double	t;
-	t_vec3	p0l0;
+	t_real	denom;
+	t_real	t;
 
 	denom = vec3_dot(plane->normal, ray->direction);
-	if (fabs(denom) < 0.0001)
+	if (REAL_FABS(denom) < REAL_EPSILON)
 		return (0);
-	p0l0 = vec3_subtract(plane->point, ray->origin);
-	t = vec3_dot(p0l0, plane->normal) / denom;
-	if (t < 0.001 || t > hit->distance)
+	t = (plane->d - vec3_dot(plane->normal, ray->origin)) / denom;
+	if (t < RAY_T_MIN || t > hit->distance)
 		return (0);
-	hit->distance = t;
-	hit->point = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
-	hit->normal = plane->normal;
-	if (vec3_dot(ray->direction, hit->normal) > 0)
-		hit->normal = vec3_multiply(hit->normal, -1);
-	hit->color = plane->color;
+	plane_set_hit(ray, plane, t, hit);
 	return (1);
 }
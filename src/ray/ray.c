@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   ray.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/16 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/16 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "ray.h"
+#include <math.h>
+
+/*
+** Shear setup of the watertight ray-triangle test (Woop, Benthin and
+** Wald 2013): kz is the dominant axis of the direction, kx and ky the
+** other two, swapped when direction[kz] is negative so triangles keep
+** their winding in ray space.
+*/
+static void	prepare_shear(t_ray *ray)
+{
+	t_real	d[3];
+	int		kz;
+
+	d[0] = ray->direction.x;
+	d[1] = ray->direction.y;
+	d[2] = ray->direction.z;
+	kz = 0;
+	if (REAL_FABS(d[1]) > REAL_FABS(d[kz]))
+		kz = 1;
+	if (REAL_FABS(d[2]) > REAL_FABS(d[kz]))
+		kz = 2;
+	ray->k[0] = (kz + 1 + (d[kz] < 0)) % 3;
+	ray->k[1] = (kz + 2 - (d[kz] < 0)) % 3;
+	ray->k[2] = kz;
+	ray->shear.x = d[ray->k[0]] / d[kz];
+	ray->shear.y = d[ray->k[1]] / d[kz];
+	ray->shear.z = 1 / d[kz];
+}
+
+/*
+** Fill inv_dir, sign and the triangle shear from direction, once per
+** ray, so slab tests multiply instead of divide. A zero component
+** gives an infinite inverse; -0 counts as negative so sign matches
+** the infinity's sign.
+*/
+void	ray_prepare(t_ray *ray)
+{
+	ray->inv_dir.x = 1 / ray->direction.x;
+	ray->inv_dir.y = 1 / ray->direction.y;
+	ray->inv_dir.z = 1 / ray->direction.z;
+	ray->sign[0] = ray->inv_dir.x < 0;
+	ray->sign[1] = ray->inv_dir.y < 0;
+	ray->sign[2] = ray->inv_dir.z < 0;
+	prepare_shear(ray);
+}
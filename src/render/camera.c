@@ -16,47 +16,27 @@
 #include "ray.h"
 #include <math.h>
 
-/* Helper structure for camera ray calculations */
-typedef struct s_cam_calc
+/*
+** Build the camera basis once per frame instead of once per ray.
+** right/up come from the view direction and world up (0, 1, 0);
+** the image plane sits at distance 1 along the view direction with
+** half-height tan(fov / 2). Pixel steps dx/dy span the full frame,
+** with y growing downwards in screen space.
+*/
+void	camera_frame_init(t_camera_frame *frame, t_camera *camera)
 {
-	double	aspect_ratio;
 	double	fov_scale;
 	t_vec3	right;
 	t_vec3	up;
-}	t_cam_calc;
 
-/*
-** Initialize camera coordinate system (right and up vectors).
-** Creates orthonormal basis from camera direction.
-** Assumes world up is (0, 1, 0) for calculating right vector.
-*/
-static void	init_camera_calc(t_camera *camera, t_cam_calc *calc)
-{
-	calc->aspect_ratio = ASPECT_RATIO;
-	calc->fov_scale = tan(camera->fov * 0.5 * M_PI / 180.0);
-	calc->right = vec3_normalize(vec3_cross(camera->direction, \
+	fov_scale = tan(camera->fov * 0.5 * M_PI / 180.0);
+	right = vec3_normalize(vec3_cross(camera->direction, \
 		(t_vec3){0, 1, 0}));
-	calc->up = vec3_normalize(vec3_cross(calc->right, camera->direction));
-}
-
-/*
-** Create camera ray for pixel at normalized coordinates (x, y).
-** x, y in range [-1, 1] where (0,0) is center of screen.
-** Calculates ray direction based on camera FOV and orientation.
-*/
-t_ray	create_camera_ray(t_camera *camera, double x, double y)
-{
-	t_ray		ray;
-	t_vec3		pixel_pos;
-	t_cam_calc	calc;
-
-	init_camera_calc(camera, &calc);
-	pixel_pos = camera->direction;
-	pixel_pos = vec3_add(pixel_pos, vec3_multiply(calc.right, \
-		x * calc.fov_scale * calc.aspect_ratio));
-	pixel_pos = vec3_add(pixel_pos, vec3_multiply(calc.up, \
-		y * calc.fov_scale));
-	ray.origin = camera->position;
-	ray.direction = vec3_normalize(pixel_pos);
-	return (ray);
+	up = vec3_normalize(vec3_cross(right, camera->direction));
+	right = vec3_multiply(right, fov_scale * ASPECT_RATIO);
+	up = vec3_multiply(up, fov_scale);
+	frame->origin = camera->position;
+	frame->corner = vec3_add(vec3_subtract(camera->direction, right), up);
+	frame->dx = vec3_multiply(right, 2.0 / WINDOW_WIDTH);
+	frame->dy = vec3_multiply(up, -2.0 / WINDOW_HEIGHT);
 }
@@ -0,0 +1,24 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet4.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** 2x2 packet kernel (4 lanes).
+** Baseline SIMD: SSE2 on x86-64, NEON on arm64.
+*/
+
+#define PACKET_LANES 4
+#define PACKET_W 2
+#define PACKET_ENTRY render_tile_packet4
+
+#include "packet_kernel.h"
+#include "packet_objects.h"
+#include "packet_trace.h"
@@ -0,0 +1,25 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet8.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** 4x2 packet kernel (8 lanes).
+** Built with -mavx2 on x86-64 (see Makefile); only called when the
+** CPU reports AVX2.
+*/
+
+#define PACKET_LANES 8
+#define PACKET_W 4
+#define PACKET_ENTRY render_tile_packet8
+
+#include "packet_kernel.h"
+#include "packet_objects.h"
+#include "packet_trace.h"
@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   packet_select.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/10 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/10 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "packet.h"
+#include "minirt.h"
+#include <stdio.h>
+
+int	cpu_has_avx2(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	return (__builtin_cpu_supports("avx2") != 0);
+#else
+	return (0);
+#endif
+}
+
+t_packet_fn	packet_select_kernel(t_simd_mode mode)
+{
+	if (mode == SIMD_OFF)
+		return (NULL);
+	if (mode == SIMD_SSE)
+		return (render_tile_packet4);
+	if (cpu_has_avx2())
+		return (render_tile_packet8);
+	if (mode == SIMD_AVX2)
+		fprintf(stderr, "Warning: CPU has no AVX2, using 4-lane packets\n");
+	return (render_tile_packet4);
+}
+
+const char	*packet_kernel_name(t_packet_fn kernel)
+{
+	if (kernel == render_tile_packet8)
+		return ("packet 4x2 (8 lanes)");
+	if (kernel == render_tile_packet4)
+		return ("packet 2x2 (4 lanes)");
+	return ("scalar");
+}
@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   progressive.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2025/12/19 21:30:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/06 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "render_state.h"
+#include "window.h"
+#include <stdlib.h>
+
+/* Tile index paired with its squared distance to the frame center */
+typedef struct s_tile_key
+{
+	long	dist;
+	int		index;
+}	t_tile_key;
+
+static int	compare_tile_keys(const void *a, const void *b)
+{
+	const t_tile_key	*ka;
+	const t_tile_key	*kb;
+
+	ka = (const t_tile_key *)a;
+	kb = (const t_tile_key *)b;
+	if (ka->dist != kb->dist)
+		return ((ka->dist > kb->dist) - (ka->dist < kb->dist));
+	return (ka->index - kb->index);
+}
+
+/*
+** Order tiles by distance of their center to the frame center so
+** the middle of the image, where the eye looks first, resolves first.
+** Distances are in doubled pixel units to stay integral.
+*/
+static int	sort_center_out(t_progressive_state *prog, int width, int height)
+{
+	t_tile_key	*keys;
+	long		dx;
+	long		dy;
+	int			i;
+
+	keys = malloc(sizeof(t_tile_key) * prog->total_tiles);
+	if (!keys)
+		return (0);
+	i = 0;
+	while (i < prog->total_tiles)
+	{
+		dx = (2L * (i % prog->tiles_x) + 1) * prog->tile_size - width;
+		dy = (2L * (i / prog->tiles_x) + 1) * prog->tile_size - height;
+		keys[i].dist = dx * dx + dy * dy;
+		keys[i].index = i;
+		i++;
+	}
+	qsort(keys, prog->total_tiles, sizeof(t_tile_key), compare_tile_keys);
+	i = 0;
+	while (i < prog->total_tiles)
+	{
+		prog->order[i] = keys[i].index;
+		i++;
+	}
+	free(keys);
+	return (1);
+}
+
+/*
+** Set up a center-out tile order for a width x height frame and
+** enable progressive mode. Returns 1 on success, 0 on failure.
+*/
+int	progressive_init(t_progressive_state *prog, int width, int height,
+		int tile_size)
+{
+	int	tiles_y;
+
+	progressive_cleanup(prog);
+	prog->tile_size = tile_size;
+	prog->tiles_x = (width + tile_size - 1) / tile_size;
+	tiles_y = (height + tile_size - 1) / tile_size;
+	prog->total_tiles = prog->tiles_x * tiles_y;
+	prog->order = malloc(sizeof(int) * prog->total_tiles);
+	if (!prog->order || !sort_center_out(prog, width, height))
+	{
+		progressive_cleanup(prog);
+		return (0);
+	}
+	prog->current_tile = 0;
+	prog->tiles_completed = 0;
+	prog->enabled = 1;
+	return (1);
+}
+
+/*
+** Return the next tile of the current pass in center-out order,
+** clipped to the window. Returns 0 once the pass is complete.
+*/
+int	progressive_next_tile(t_progressive_state *prog, int *x, int *y, int *w,
+		int *h)
+{
+	int	tile;
+
+	if (!prog->enabled || !prog->order
+		|| prog->current_tile >= prog->total_tiles)
+		return (0);
+	tile = prog->order[prog->current_tile];
+	*x = (tile % prog->tiles_x) * prog->tile_size;
+	*y = (tile / prog->tiles_x) * prog->tile_size;
+	*w = prog->tile_size;
+	*h = prog->tile_size;
+	if (*x + *w > WINDOW_WIDTH)
+		*w = WINDOW_WIDTH - *x;
+	if (*y + *h > WINDOW_HEIGHT)
+		*h = WINDOW_HEIGHT - *y;
+	prog->current_tile++;
+	return (1);
+}
+
+void	progressive_reset(t_progressive_state *prog)
+{
+	prog->current_tile = 0;
+	prog->tiles_completed = 0;
+}
+
+void	progressive_cleanup(t_progressive_state *prog)
+{
+	free(prog->order);
+	prog->order = NULL;
+	prog->enabled = 0;
+	prog->total_tiles = 0;
+	prog->current_tile = 0;
+}
@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   progressive_render.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/06 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/06 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "window.h"
+#include "render_pool.h"
+#include "metrics.h"
+
+/* Largest number of tiles dispatched to the pool in one batch */
+#define PROGRESSIVE_MAX_BATCH 512
+
+/*
+** Pull up to max tiles of the current pass into batch.
+** Returns the number of tiles collected.
+*/
+static int	collect_batch(t_progressive_state *prog, t_tile *batch, int max)
+{
+	int	count;
+
+	count = 0;
+	while (count < max && progressive_next_tile(prog, &batch[count].x,
+			&batch[count].y, &batch[count].w, &batch[count].h))
+		count++;
+	return (count);
+}
+
+/*
+** Render a batch of tiles, spread over the pool when available.
+** Returns the number of rays traced.
+*/
+static long	render_batch(t_render *render, t_tile *batch, int count)
+{
+	long	rays;
+	int		i;
+
+	if (render->pool)
+		return (render_pool_run(render->pool, render, batch, count));
+	rays = 0;
+	i = 0;
+	while (i < count)
+		rays += render_tile(render, &batch[i++]);
+	return (rays);
+}
+
+static int	batch_size(t_render *render)
+{
+	int	size;
+
+	size = 2;
+	if (render->pool)
+		size = render->pool->thread_count * 2;
+	if (size > PROGRESSIVE_MAX_BATCH)
+		size = PROGRESSIVE_MAX_BATCH;
+	return (size);
+}
+
+/*
+** Render as many tiles of the current pass as fit in the per-tick
+** budget, then present the partial image. Batches hold two tiles
+** per worker so every thread stays busy between budget checks.
+** The camera basis is refreshed each step; a camera move marks the
+** scene dirty, which restarts the pass anyway.
+** Returns 1 when this call completed the pass, 0 otherwise.
+*/
+int	progressive_render_step(t_render *render)
+{
+	t_progressive_state	*prog;
+	t_tile				batch[PROGRESSIVE_MAX_BATCH];
+	struct timeval		start;
+	int					count;
+
+	prog = &render->scene->render_state.progressive;
+	if (!prog->enabled || prog->tiles_completed >= prog->total_tiles)
+		return (0);
+	camera_frame_init(&render->camera, &render->scene->camera);
+	timer_start(&start);
+	count = collect_batch(prog, batch, batch_size(render));
+	while (count > 0)
+	{
+		render->scene->render_state.metrics.rays_traced
+			+= render_batch(render, batch, count);
+		prog->tiles_completed += count;
+		if (timer_elapsed_us(&start) >= PROGRESSIVE_BUDGET_US)
+			break ;
+		count = collect_batch(prog, batch, batch_size(render));
+	}
+	mlx_put_image_to_window(render->mlx, render->win, render->img, 0, 0);
+	return (prog->tiles_completed >= prog->total_tiles);
+}
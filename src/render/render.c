@@ -13,25 +13,15 @@
 #include "minirt.h"
 #include "ray.h"
 #include "window.h"
+#include "render_pool.h"
 
-t_ray		create_camera_ray(t_camera *camera, double x, double y);
 t_color		trace_ray(t_scene *scene, t_ray *ray);
 
-/*
-** Convert screen pixel coordinates to Normalized Device Coordinates.
-** NDC range: u in [-1, 1] (left to right), v in [-1, 1] (bottom to top).
-*/
-static inline void	screen_to_ndc(int x, int y, double *u, double *v)
-{
-	*u = (2.0 * x / (double)WINDOW_WIDTH) - 1.0;
-	*v = 1.0 - (2.0 * y / (double)WINDOW_HEIGHT);
-}
-
 /*
 ** Write color directly to image buffer for fast rendering.
 ** Converts RGB color to packed integer and writes to memory.
 */
-static void	put_pixel_to_buffer(t_render *render, int x, int y, t_color color)
+void	put_pixel_to_buffer(t_render *render, int x, int y, t_color color)
 {
 	int		offset;
 	int		pixel_color;
@@ -44,86 +34,110 @@ static void	put_pixel_to_buffer(t_render *render, int x, int y, t_color color)
 }
 
 /*
-** Render single pixel at screen coordinates (x, y).
-** Converts screen space to normalized device coordinates.
-** Creates camera ray, traces it, and writes resulting color to buffer.
+** Fill a block (1x1, or 2x2 in low quality) with one color, clipped
+** to its tile so neighbouring tiles never write the same pixel.
 */
-static void	render_pixel(t_scene *scene, t_render *render, int x, int y)
+static void	fill_block(t_render *render, t_tile *tile, t_tile *block,
+		t_color color)
 {
-	t_ray	ray;
-	t_color	color;
-	double	u;
-	double	v;
+	int	x;
+	int	y;
 
-	screen_to_ndc(x, y, &u, &v);
-	ray = create_camera_ray(&scene->camera, u, v);
-	color = trace_ray(scene, &ray);
-	put_pixel_to_buffer(render, x, y, color);
+	y = block->y;
+	while (y < block->y + block->h && y < tile->y + tile->h)
+	{
+		x = block->x;
+		while (x < block->x + block->w && x < tile->x + tile->w)
+		{
+			put_pixel_to_buffer(render, x, y, color);
+			x++;
+		}
+		y++;
+	}
 }
 
 /*
-** Render scene at reduced resolution for fast preview.
-** Uses 2x2 pixel blocks to achieve 4x speedup.
+** Trace one row of a tile. The row's first direction is derived from
+** the frame basis once; each further pixel only adds the x step.
+** Returns the number of rays traced.
 */
-static void	render_low_quality(t_scene *scene, t_render *render)
+static long	render_row(t_render *render, t_tile *tile, int y, int step)
 {
-	int		x;
-	int		y;
-	t_ray	ray;
-	t_color	color;
-	double	u;
-	double	v;
+	t_camera_frame	*cam;
+	t_ray			ray;
+	t_vec3			dir;
+	t_vec3			dx;
+	t_tile			block;
 
-	y = 0;
-	while (y < WINDOW_HEIGHT)
+	cam = &render->camera;
+	dir = vec3_add(vec3_add(cam->corner, vec3_multiply(cam->dy, y)),
+			vec3_multiply(cam->dx, tile->x));
+	dx = vec3_multiply(cam->dx, step);
+	ray.origin = cam->origin;
+	block = (t_tile){tile->x, y, step, step};
+	while (block.x < tile->x + tile->w)
 	{
-		x = 0;
-		while (x < WINDOW_WIDTH)
-		{
-			screen_to_ndc(x, y, &u, &v);
-			ray = create_camera_ray(&scene->camera, u, v);
-			color = trace_ray(scene, &ray);
-			put_pixel_to_buffer(render, x, y, color);
-			if (x + 1 < WINDOW_WIDTH)
-				put_pixel_to_buffer(render, x + 1, y, color);
-			if (y + 1 < WINDOW_HEIGHT)
-			{
-				put_pixel_to_buffer(render, x, y + 1, color);
-				if (x + 1 < WINDOW_WIDTH)
-					put_pixel_to_buffer(render, x + 1, y + 1, color);
-			}
-			x += 2;
-		}
-		y += 2;
+		ray.direction = vec3_normalize(dir);
+		fill_block(render, tile, &block, trace_ray(render->scene, &ray));
+		dir = vec3_add(dir, dx);
+		block.x += step;
 	}
+	return ((tile->w + step - 1) / step);
 }
 
 /*
-** Render entire scene to image buffer.
-** Uses low quality mode if requested for faster preview.
-** Otherwise renders at full 800x600 resolution.
+** Render every pixel of a tile into the image buffer.
+** Low quality mode traces one ray per 2x2 block for a 4x speedup;
+** tile origins are even, so blocks match a full-frame pass.
+** Full-quality tiles go to the SIMD packet kernel when one is set and
+** the active accelerator has a packet walk (accel_has_packets).
+** render->camera must be set up for the frame (camera_frame_init).
+** Returns the number of rays traced.
 */
-void	render_scene_to_buffer(t_scene *scene, t_render *render)
+long	render_tile(t_render *render, t_tile *tile)
 {
-	int		x;
 	int		y;
+	int		step;
+	long	rays;
 
+	if (render->packet && !render->low_quality
+		&& tile->w <= RENDER_TILE_SIZE && accel_has_packets(render->scene))
+		return (render->packet(render, tile));
+	step = 1;
 	if (render->low_quality)
+		step = 2;
+	rays = 0;
+	y = tile->y;
+	while (y < tile->y + tile->h)
 	{
-		render_low_quality(scene, render);
-		return ;
+		rays += render_row(render, tile, y, step);
+		y += step;
 	}
-	y = 0;
-	while (y < WINDOW_HEIGHT)
+	return (rays);
+}
+
+/*
+** Render entire scene to image buffer.
+** Tiles are spread over the render pool when one is attached,
+** otherwise the whole frame is traced on the calling thread.
+** Output is identical for every thread count.
+*/
+void	render_scene_to_buffer(t_scene *scene, t_render *render)
+{
+	t_tile	frame;
+	long	rays;
+
+	render->scene = scene;
+	camera_frame_init(&render->camera, &scene->camera);
+	if (render->pool)
+		rays = render_pool_run(render->pool, render,
+				render->pool->frame_tiles, render->pool->frame_tile_count);
+	else
 	{
-		x = 0;
-		while (x < WINDOW_WIDTH)
-		{
-			render_pixel(scene, render, x, y);
-			x++;
-		}
-		y++;
+		frame = (t_tile){0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
+		rays = render_tile(render, &frame);
 	}
+	scene->render_state.metrics.rays_traced += rays;
 }
 
 /*
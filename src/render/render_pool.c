@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_pool.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/05 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/05 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "render_pool.h"
+#include "window.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+void	*render_worker_main(void *arg);
+
+/*
+** Number of online CPUs, clamped to [1, RENDER_MAX_THREADS].
+*/
+int	render_default_thread_count(void)
+{
+	long	cpus;
+
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 1)
+		return (1);
+	if (cpus > RENDER_MAX_THREADS)
+		return (RENDER_MAX_THREADS);
+	return ((int)cpus);
+}
+
+/*
+** Split a width x height frame into row-major tiles of tile_size.
+** Tiles on the right and bottom edges are clipped to the frame.
+** Returns the number of tiles written.
+*/
+int	render_build_tiles(t_tile *tiles, int width, int height, int tile_size)
+{
+	int	x;
+	int	y;
+	int	count;
+
+	count = 0;
+	y = 0;
+	while (y < height)
+	{
+		x = 0;
+		while (x < width)
+		{
+			tiles[count].x = x;
+			tiles[count].y = y;
+			tiles[count].w = tile_size;
+			tiles[count].h = tile_size;
+			if (x + tile_size > width)
+				tiles[count].w = width - x;
+			if (y + tile_size > height)
+				tiles[count].h = height - y;
+			count++;
+			x += tile_size;
+		}
+		y += tile_size;
+	}
+	return (count);
+}
+
+/*
+** Allocate workers, their deques and the full-frame tile list.
+** Every deque can hold the whole frame so any split fits.
+*/
+static int	pool_alloc(t_render_pool *pool)
+{
+	int	capacity;
+	int	i;
+
+	capacity = ((WINDOW_WIDTH + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE)
+		* ((WINDOW_HEIGHT + RENDER_TILE_SIZE - 1) / RENDER_TILE_SIZE);
+	pool->frame_tiles = malloc(sizeof(t_tile) * capacity);
+	pool->workers = calloc(pool->thread_count, sizeof(t_render_worker));
+	if (!pool->frame_tiles || !pool->workers)
+		return (0);
+	pool->frame_tile_count = render_build_tiles(pool->frame_tiles,
+			WINDOW_WIDTH, WINDOW_HEIGHT, RENDER_TILE_SIZE);
+	i = 0;
+	while (i < pool->thread_count)
+	{
+		pool->workers[i].id = i;
+		pool->workers[i].pool = pool;
+		if (!deque_init(&pool->workers[i].deque, capacity))
+			return (0);
+		i++;
+	}
+	return (1);
+}
+
+/*
+** Create a render pool with thread_count workers (0 = one per CPU).
+** Worker 0 runs on the caller, so only thread_count - 1 threads
+** are spawned. Returns NULL on failure.
+*/
+t_render_pool	*render_pool_create(int thread_count)
+{
+	t_render_pool	*pool;
+	int				i;
+
+	pool = calloc(1, sizeof(t_render_pool));
+	if (!pool)
+		return (NULL);
+	pool->thread_count = thread_count;
+	if (thread_count <= 0)
+		pool->thread_count = render_default_thread_count();
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	if (!pool_alloc(pool))
+	{
+		render_pool_destroy(pool);
+		return (NULL);
+	}
+	i = 1;
+	while (i < pool->thread_count)
+	{
+		if (pthread_create(&pool->workers[i].thread, NULL,
+				render_worker_main, &pool->workers[i]) != 0)
+		{
+			render_pool_destroy(pool);
+			return (NULL);
+		}
+		pool->workers[i++].started = 1;
+	}
+	return (pool);
+}
+
+/*
+** Stop and join all worker threads, then release pool memory.
+*/
+void	render_pool_destroy(t_render_pool *pool)
+{
+	int	i;
+
+	if (!pool)
+		return ;
+	pthread_mutex_lock(&pool->lock);
+	pool->shutdown = 1;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	i = 0;
+	while (pool->workers && i < pool->thread_count)
+	{
+		if (pool->workers[i].started)
+			pthread_join(pool->workers[i].thread, NULL);
+		deque_destroy(&pool->workers[i].deque);
+		i++;
+	}
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->wake);
+	pthread_mutex_destroy(&pool->lock);
+	free(pool->workers);
+	free(pool->frame_tiles);
+	free(pool);
+}
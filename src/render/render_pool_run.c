@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_pool_run.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/05 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/05 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "render_pool.h"
+#include "window.h"
+
+/*
+** Try to steal one tile from any other worker, starting with the
+** next worker id so thieves spread over different victims.
+*/
+static int	steal_tile(t_render_worker *worker, t_tile *tile)
+{
+	t_render_pool	*pool;
+	int				i;
+	int				victim;
+
+	pool = worker->pool;
+	i = 1;
+	while (i < pool->thread_count)
+	{
+		victim = (worker->id + i) % pool->thread_count;
+		if (deque_steal(&pool->workers[victim].deque, tile))
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/*
+** Render tiles from the own deque, then steal until every deque is
+** empty. Tiles never spawn new work, so empty deques mean done.
+*/
+static void	worker_drain(t_render_worker *worker)
+{
+	t_tile	tile;
+
+	while (deque_pop(&worker->deque, &tile) || steal_tile(worker, &tile))
+		worker->rays += render_tile(worker->pool->render, &tile);
+}
+
+/*
+** Worker thread body: sleep until a new generation is published,
+** drain tiles, report completion, repeat until shutdown.
+*/
+void	*render_worker_main(void *arg)
+{
+	t_render_worker	*worker;
+	t_render_pool	*pool;
+	long			seen;
+
+	worker = (t_render_worker *)arg;
+	pool = worker->pool;
+	seen = 0;
+	while (1)
+	{
+		pthread_mutex_lock(&pool->lock);
+		while (!pool->shutdown && pool->generation == seen)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		seen = pool->generation;
+		if (pool->shutdown)
+			break ;
+		pthread_mutex_unlock(&pool->lock);
+		worker_drain(worker);
+		pthread_mutex_lock(&pool->lock);
+		pool->busy--;
+		if (pool->busy == 0)
+			pthread_cond_signal(&pool->done);
+		pthread_mutex_unlock(&pool->lock);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return (NULL);
+}
+
+/*
+** Deal tiles out in contiguous runs so each worker starts on a
+** compact screen region (better cache reuse of scene data).
+*/
+static void	distribute_tiles(t_render_pool *pool, t_tile *tiles, int count)
+{
+	int	i;
+	int	w;
+
+	w = 0;
+	while (w < pool->thread_count)
+	{
+		pool->workers[w].deque.head = 0;
+		pool->workers[w].deque.tail = 0;
+		pool->workers[w].rays = 0;
+		w++;
+	}
+	i = 0;
+	while (i < count)
+	{
+		w = (int)((long)i * pool->thread_count / count);
+		deque_push(&pool->workers[w].deque, tiles[i]);
+		i++;
+	}
+}
+
+/*
+** Render count tiles with every worker and wait for completion.
+** Pixels are independent, so output does not depend on which
+** worker renders which tile. Returns the number of rays traced.
+*/
+long	render_pool_run(t_render_pool *pool, t_render *render, t_tile *tiles,
+		int count)
+{
+	long	rays;
+	int		i;
+
+	pool->render = render;
+	distribute_tiles(pool, tiles, count);
+	pthread_mutex_lock(&pool->lock);
+	pool->busy = pool->thread_count - 1;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	worker_drain(&pool->workers[0]);
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy > 0)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	rays = 0;
+	i = 0;
+	while (i < pool->thread_count)
+		rays += pool->workers[i++].rays;
+	return (rays);
+}
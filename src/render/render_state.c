@@ -11,8 +11,8 @@
 /* ************************************************************************** */
 
 #include "render_state.h"
-#include "window.h"
 #include <stdlib.h>
+#include <string.h>
 
 void	render_state_init(t_render_state *state)
 {
@@ -26,20 +26,40 @@ void	render_state_init(t_render_state *state)
 	state->progressive.total_tiles = 0;
 	state->progressive.tiles_completed = 0;
 	state->progressive.tile_size = 32;
+	state->progressive.tiles_x = 0;
+	state->progressive.order = NULL;
 	metrics_init(&state->metrics);
 	state->bvh = NULL;
+	state->grid = NULL;
+	state->octree = NULL;
 	state->adaptive_enabled = 0;
-	state->bvh_enabled = 0;
+	state->accel = ACCEL_BVH;
+	state->accel_stale = 0;
+	memset(state->accel_stats, 0, sizeof(state->accel_stats));
+	state->bvh_config.builder = BVH_BUILDER_SAH;
+	state->bvh_config.traversal = BVH_TRAVERSAL_ORDERED;
+	state->bvh_config.width = BVH_DEFAULT_WIDTH;
+	state->bvh_config.threads = 0;
+	state->bvh_config.cache = 0;
+	state->bvh_config.stats = 0;
+	state->bvh_cache = NULL;
 	state->show_info = 1;
 }
 
 void	render_state_cleanup(t_render_state *state)
 {
+	progressive_cleanup(&state->progressive);
+	free(state->bvh_cache);
+	state->bvh_cache = NULL;
 	if (state->bvh)
 	{
 		bvh_destroy(state->bvh);
 		state->bvh = NULL;
 	}
+	grid_destroy(state->grid);
+	state->grid = NULL;
+	octree_destroy(state->octree);
+	state->octree = NULL;
 }
 
 void	render_state_update(t_render_state *state)
@@ -77,48 +97,3 @@ void	quality_handle_interaction(t_render_state *state)
 	if (state->adaptive_enabled && state->target_quality == QUALITY_HIGH)
 		state->quality = QUALITY_LOW;
 }
-
-void	progressive_init(t_progressive_state *prog, int width, int height,
-		int tile_size)
-{
-	int	tiles_x;
-	int	tiles_y;
-
-	prog->tile_size = tile_size;
-	tiles_x = (width + tile_size - 1) / tile_size;
-	tiles_y = (height + tile_size - 1) / tile_size;
-	prog->total_tiles = tiles_x * tiles_y;
-	prog->current_tile = 0;
-	prog->tiles_completed = 0;
-	prog->enabled = 1;
-}
-
-int	progressive_next_tile(t_progressive_state *prog, int *x, int *y, int *w,
-		int *h)
-{
-	int	tiles_x;
-	int	tile_x;
-	int	tile_y;
-
-	if (!prog->enabled || prog->current_tile >= prog->total_tiles)
-		return (0);
-	tiles_x = (800 + prog->tile_size - 1) / prog->tile_size;
-	tile_x = prog->current_tile % tiles_x;
-	tile_y = prog->current_tile / tiles_x;
-	*x = tile_x * prog->tile_size;
-	*y = tile_y * prog->tile_size;
-	*w = prog->tile_size;
-	*h = prog->tile_size;
-	if (*x + *w > WINDOW_WIDTH)
-		*w = WINDOW_WIDTH - *x;
-	if (*y + *h > WINDOW_HEIGHT)
-		*h = WINDOW_HEIGHT - *y;
-	prog->current_tile++;
-	return (1);
-}
-
-void	progressive_reset(t_progressive_state *prog)
-{
-	prog->current_tile = 0;
-	prog->tiles_completed = 0;
-}
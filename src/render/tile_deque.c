@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tile_deque.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/05 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/05 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "render_pool.h"
+#include <stdlib.h>
+
+/*
+** Allocate deque storage for up to capacity tiles.
+** Returns 1 on success, 0 on allocation failure.
+*/
+int	deque_init(t_tile_deque *dq, int capacity)
+{
+	dq->tiles = malloc(sizeof(t_tile) * capacity);
+	if (!dq->tiles)
+		return (0);
+	dq->head = 0;
+	dq->tail = 0;
+	if (pthread_mutex_init(&dq->lock, NULL) != 0)
+	{
+		free(dq->tiles);
+		dq->tiles = NULL;
+		return (0);
+	}
+	return (1);
+}
+
+void	deque_destroy(t_tile_deque *dq)
+{
+	if (!dq->tiles)
+		return ;
+	pthread_mutex_destroy(&dq->lock);
+	free(dq->tiles);
+	dq->tiles = NULL;
+}
+
+/*
+** Append tile at the tail. Only called while the pool is idle,
+** before the generation bump that publishes the work to workers.
+*/
+void	deque_push(t_tile_deque *dq, t_tile tile)
+{
+	dq->tiles[dq->tail] = tile;
+	dq->tail++;
+}
+
+/*
+** Owner side: take the most recently pushed tile (LIFO).
+** Returns 1 if a tile was taken, 0 if the deque is empty.
+*/
+int	deque_pop(t_tile_deque *dq, t_tile *tile)
+{
+	int	found;
+
+	found = 0;
+	pthread_mutex_lock(&dq->lock);
+	if (dq->tail > dq->head)
+	{
+		dq->tail--;
+		*tile = dq->tiles[dq->tail];
+		found = 1;
+	}
+	pthread_mutex_unlock(&dq->lock);
+	return (found);
+}
+
+/*
+** Thief side: take the oldest tile (FIFO) so owner and thief
+** work from opposite ends and rarely contend for the same slot.
+*/
+int	deque_steal(t_tile_deque *dq, t_tile *tile)
+{
+	int	found;
+
+	found = 0;
+	pthread_mutex_lock(&dq->lock);
+	if (dq->tail > dq->head)
+	{
+		*tile = dq->tiles[dq->head];
+		dq->head++;
+		found = 1;
+	}
+	pthread_mutex_unlock(&dq->lock);
+	return (found);
+}
@@ -13,7 +13,6 @@
 #include "minirt.h"
 #include "ray.h"
 #include "spatial.h"
-#include "metrics.h"
 #include <math.h>
 
 /*
@@ -49,26 +48,24 @@ static int	check_intersections_generic(void *objects, int count, \
 
 /*
 ** Check ray intersection with all spheres in scene.
+** Spheres are tested several at a time from the SoA arrays.
 ** Updates hit info with closest sphere intersection.
 ** Returns 1 if any sphere was hit, 0 otherwise.
 */
 int	check_sphere_intersections(t_scene *scene, t_ray *ray, t_hit *hit)
 {
-	return (check_intersections_generic(scene->spheres, \
-		scene->sphere_count, sizeof(t_sphere), \
-		(t_intersect_fn)intersect_sphere, ray, hit));
+	return (intersect_spheres(scene, ray, hit));
 }
 
 /*
 ** Check ray intersection with all planes in scene.
+** Planes are in no accelerator, so every backend uses this loop.
 ** Updates hit info with closest plane intersection.
 ** Returns 1 if any plane was hit, 0 otherwise.
 */
 int	check_plane_intersections(t_scene *scene, t_ray *ray, t_hit *hit)
 {
-	return (check_intersections_generic(scene->planes, \
-		scene->plane_count, sizeof(t_plane), \
-		(t_intersect_fn)intersect_plane, ray, hit));
+	return (intersect_planes(scene, ray, hit));
 }
 
 /*
@@ -83,33 +80,58 @@ int	check_cylinder_intersections(t_scene *scene, t_ray *ray, t_hit *hit)
 		(t_intersect_fn)intersect_cylinder, ray, hit));
 }
 
+/*
+** Check ray intersection with every instance in scene.
+** Each one walks its group's BVH in group space.
+** Returns 1 if any instance was hit, 0 otherwise.
+*/
+int	check_instance_intersections(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	int	i;
+	int	hit_found;
+
+	hit_found = 0;
+	i = 0;
+	while (i < scene->instance_count)
+	{
+		if (instance_intersect(scene, &scene->instances[i], ray, hit))
+			hit_found = 1;
+		i++;
+	}
+	return (hit_found);
+}
+
+/*
+** Closest hit among all bounded objects by brute force: the
+** intersect query of the "none" accelerator.
+*/
+int	objects_intersect(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	int	hit_found;
+
+	hit_found = check_sphere_intersections(scene, ray, hit);
+	hit_found |= check_cylinder_intersections(scene, ray, hit);
+	hit_found |= check_instance_intersections(scene, ray, hit);
+	return (hit_found);
+}
+
 /*
 ** Trace ray through scene and determine pixel color.
-** Tests intersection with all objects and finds closest hit.
-** Uses BVH acceleration if enabled, otherwise brute force.
+** Bounded objects go through the active accelerator (accel_intersect),
+** planes are always tested in their own loop.
 ** Returns lit color if object hit, black if no intersection.
+** Only reads the scene, so render workers may call it concurrently;
+** rays are counted per tile by the renderer.
 */
 t_color	trace_ray(t_scene *scene, t_ray *ray)
 {
 	t_hit	hit;
 	int		hit_found;
 
-	metrics_add_ray(&scene->render_state.metrics);
-	hit_found = 0;
 	hit.distance = INFINITY;
-	if (scene->render_state.bvh_enabled && scene->render_state.bvh)
-	{
-		hit_found = bvh_intersect(scene->render_state.bvh, *ray, &hit, scene);
-	}
-	else
-	{
-		if (check_sphere_intersections(scene, ray, &hit))
-			hit_found = 1;
-		if (check_plane_intersections(scene, ray, &hit))
-			hit_found = 1;
-		if (check_cylinder_intersections(scene, ray, &hit))
-			hit_found = 1;
-	}
+	ray_prepare(ray);
+	hit_found = accel_intersect(scene, ray, &hit);
+	hit_found |= check_plane_intersections(scene, ray, &hit);
 	if (hit_found)
 		return (apply_lighting(scene, &hit));
 	return ((t_color){0, 0, 0});
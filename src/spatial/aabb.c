@@ -14,14 +14,14 @@
 #include "minirt.h"
 #include <math.h>
 
-static double	min_double(double a, double b)
+static t_real	min_real(t_real a, t_real b)
 {
 	if (a < b)
 		return (a);
 	return (b);
 }
 
-static double	max_double(double a, double b)
+static t_real	max_real(t_real a, t_real b)
 {
 	if (a > b)
 		return (a);
@@ -41,16 +41,16 @@ t_aabb	aabb_merge(t_aabb a, t_aabb b)
 {
 	t_aabb	result;
 
-	result.min.x = min_double(a.min.x, b.min.x);
-	result.min.y = min_double(a.min.y, b.min.y);
-	result.min.z = min_double(a.min.z, b.min.z);
-	result.max.x = max_double(a.max.x, b.max.x);
-	result.max.y = max_double(a.max.y, b.max.y);
-	result.max.z = max_double(a.max.z, b.max.z);
+	result.min.x = min_real(a.min.x, b.min.x);
+	result.min.y = min_real(a.min.y, b.min.y);
+	result.min.z = min_real(a.min.z, b.min.z);
+	result.max.x = max_real(a.max.x, b.max.x);
+	result.max.y = max_real(a.max.y, b.max.y);
+	result.max.z = max_real(a.max.z, b.max.z);
 	return (result);
 }
 
-t_aabb	aabb_for_sphere(t_vec3 center, double radius)
+t_aabb	aabb_for_sphere(t_vec3 center, t_real radius)
 {
 	t_aabb	box;
 	t_vec3	offset;
@@ -63,21 +63,21 @@ t_aabb	aabb_for_sphere(t_vec3 center, double radius)
 	return (box);
 }
 
-t_aabb	aabb_for_cylinder(t_vec3 center, t_vec3 axis, double radius,
-		double height)
+t_aabb	aabb_for_cylinder(t_vec3 center, t_vec3 axis, t_real radius,
+		t_real height)
 {
 	t_aabb	box;
 	t_vec3	half_axis;
-	double	extent;
+	t_real	extent;
 
-	half_axis = vec3_multiply(axis, height / 2.0);
-	extent = radius + fabs(half_axis.x);
+	half_axis = vec3_multiply(axis, height / 2);
+	extent = radius + REAL_FABS(half_axis.x);
 	box.min.x = center.x - extent;
 	box.max.x = center.x + extent;
-	extent = radius + fabs(half_axis.y);
+	extent = radius + REAL_FABS(half_axis.y);
 	box.min.y = center.y - extent;
 	box.max.y = center.y + extent;
-	extent = radius + fabs(half_axis.z);
+	extent = radius + REAL_FABS(half_axis.z);
 	box.min.z = center.z - extent;
 	box.max.z = center.z + extent;
 	return (box);
@@ -86,7 +86,7 @@ t_aabb	aabb_for_cylinder(t_vec3 center, t_vec3 axis, double radius,
 t_aabb	aabb_for_plane(t_vec3 point, t_vec3 normal)
 {
 	t_aabb	box;
-	double	large;
+	t_real	large;
 
 	large = 1000000.0;
 	(void)normal;
@@ -99,64 +99,50 @@ t_aabb	aabb_for_plane(t_vec3 point, t_vec3 normal)
 	return (box);
 }
 
-double	aabb_surface_area(t_aabb box)
+t_real	aabb_surface_area(t_aabb box)
 {
-	double	dx;
-	double	dy;
-	double	dz;
+	t_real	dx;
+	t_real	dy;
+	t_real	dz;
 
 	dx = box.max.x - box.min.x;
 	dy = box.max.y - box.min.y;
 	dz = box.max.z - box.min.z;
-	return (2.0 * (dx * dy + dy * dz + dz * dx));
+	return (2 * (dx * dy + dy * dz + dz * dx));
 }
 
-int	aabb_intersect(t_aabb box, t_ray ray, double *t_min, double *t_max)
+/* One slab: near and far are the ray distances to its two planes */
+static void	slab(t_real near, t_real far, t_real *t_min, t_real *t_max)
 {
-	double	t0;
-	double	t1;
-	double	tmin;
-	double	tmax;
-
-	tmin = (*t_min);
-	tmax = (*t_max);
-	t0 = (box.min.x - ray.origin.x) / ray.direction.x;
-	t1 = (box.max.x - ray.origin.x) / ray.direction.x;
-	if (t0 > t1)
-	{
-		tmin = max_double(tmin, t1);
-		tmax = min_double(tmax, t0);
-	}
-	else
-	{
-		tmin = max_double(tmin, t0);
-		tmax = min_double(tmax, t1);
-	}
-	t0 = (box.min.y - ray.origin.y) / ray.direction.y;
-	t1 = (box.max.y - ray.origin.y) / ray.direction.y;
-	if (t0 > t1)
-	{
-		tmin = max_double(tmin, t1);
-		tmax = min_double(tmax, t0);
-	}
-	else
-	{
-		tmin = max_double(tmin, t0);
-		tmax = min_double(tmax, t1);
-	}
-	t0 = (box.min.z - ray.origin.z) / ray.direction.z;
-	t1 = (box.max.z - ray.origin.z) / ray.direction.z;
-	if (t0 > t1)
-	{
-		tmin = max_double(tmin, t1);
-		tmax = min_double(tmax, t0);
-	}
-	else
-	{
-		tmin = max_double(tmin, t0);
-		tmax = min_double(tmax, t1);
-	}
-	*t_min = tmin;
-	*t_max = tmax;
-	return (tmax >= tmin && tmax > 0);
+	*t_min = max_real(near, *t_min);
+	*t_max = min_real(far * AABB_TMAX_SCALE, *t_max);
+}
+
+/*
+** Branch-free slab test on a prepared ray (ray_prepare). sign picks
+** the near and far corner per axis, so no swap is needed. Exit
+** distances are widened by AABB_TMAX_SCALE so that rounding error
+** never rejects a box the ray grazes, which matters most in the
+** float build. A zero direction component gives +-inf distances, or
+** NaN when the origin lies on the slab plane; max_real / min_real
+** keep the current range for NaN, so such a ray counts as inside
+** that slab.
+*/
+int	aabb_intersect(const t_aabb *box, const t_ray *ray, t_real *t_min,
+		t_real *t_max)
+{
+	const t_vec3	*corner[2];
+
+	corner[0] = &box->min;
+	corner[1] = &box->max;
+	slab((corner[ray->sign[0]]->x - ray->origin.x) * ray->inv_dir.x,
+		(corner[1 - ray->sign[0]]->x - ray->origin.x) * ray->inv_dir.x,
+		t_min, t_max);
+	slab((corner[ray->sign[1]]->y - ray->origin.y) * ray->inv_dir.y,
+		(corner[1 - ray->sign[1]]->y - ray->origin.y) * ray->inv_dir.y,
+		t_min, t_max);
+	slab((corner[ray->sign[2]]->z - ray->origin.z) * ray->inv_dir.z,
+		(corner[1 - ray->sign[2]]->z - ray->origin.z) * ray->inv_dir.z,
+		t_min, t_max);
+	return (*t_max >= *t_min && *t_max > 0);
 }
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   accel.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:12:09 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 13:12:09 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "accel.h"
+#include <stddef.h>
+#include <string.h>
+
+static int	bvh_backend_intersect(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	return (bvh_intersect(scene->render_state.bvh, *ray, hit, scene));
+}
+
+static int	bvh_backend_occluded(t_scene *scene, t_ray *ray,
+		t_real max_distance)
+{
+	return (bvh_occluded(scene->render_state.bvh, *ray, max_distance,
+			scene));
+}
+
+static int	grid_backend_intersect(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	return (grid_intersect(scene->render_state.grid, scene, ray, hit));
+}
+
+static int	grid_backend_occluded(t_scene *scene, t_ray *ray,
+		t_real max_distance)
+{
+	return (grid_occluded(scene->render_state.grid, scene, ray,
+			max_distance));
+}
+
+static int	octree_backend_intersect(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	return (octree_intersect(scene->render_state.octree, scene, ray, hit));
+}
+
+static int	octree_backend_occluded(t_scene *scene, t_ray *ray,
+		t_real max_distance)
+{
+	return (octree_occluded(scene->render_state.octree, scene, ray,
+			max_distance));
+}
+
+/*
+** Backends by t_accel_kind; "none" is the brute-force loop over every
+** object.
+*/
+const t_accel_ops	*accel_ops(int kind)
+{
+	static const t_accel_ops	ops[ACCEL_COUNT] = {
+	{"bvh", accel_build_bvh, scene_report_bvh,
+		bvh_backend_intersect, bvh_backend_occluded},
+	{"grid", accel_build_grid, accel_report_grid,
+		grid_backend_intersect, grid_backend_occluded},
+	{"octree", accel_build_octree, accel_report_octree,
+		octree_backend_intersect, octree_backend_occluded},
+	{"none", NULL, NULL, objects_intersect, objects_occlude}};
+
+	if (kind < 0 || kind >= ACCEL_COUNT)
+		kind = ACCEL_NONE;
+	return (&ops[kind]);
+}
+
+/* t_accel_kind named name ("bvh", "grid", ...), -1 if there is none */
+int	accel_parse(const char *name)
+{
+	int	kind;
+
+	kind = 0;
+	while (kind < ACCEL_COUNT)
+	{
+		if (strcmp(accel_ops(kind)->name, name) == 0)
+			return (kind);
+		kind++;
+	}
+	return (-1);
+}
+
+/* Closest bounded object below hit->distance; ray must be prepared */
+int	accel_intersect(t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	return (accel_ops(scene->render_state.accel)->intersect(scene, ray,
+			hit));
+}
+
+/* 1 if a bounded object lies closer than max_distance along ray */
+int	accel_occluded(t_scene *scene, t_ray *ray, t_real max_distance)
+{
+	return (accel_ops(scene->render_state.accel)->occluded(scene, ray,
+			max_distance));
+}
+
+/*
+** The packet kernels walk the BVH or loop over every object
+** themselves; other backends trace tiles one ray at a time.
+*/
+int	accel_has_packets(t_scene *scene)
+{
+	return (scene->render_state.accel == ACCEL_BVH
+		|| scene->render_state.accel == ACCEL_NONE);
+}
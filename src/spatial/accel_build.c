@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   accel_build.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:31:50 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 13:31:50 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "accel.h"
+#include <stdlib.h>
+
+/*
+** The scene BVH, unless one exists already; refits keep it current.
+** Its memory includes the groups' BVHs under it.
+*/
+void	accel_build_bvh(t_scene *scene)
+{
+	t_bvh			*bvh;
+	t_accel_stats	*stats;
+
+	if (!scene->render_state.bvh)
+		scene_build_bvh(scene);
+	bvh = scene->render_state.bvh;
+	if (!bvh || !bvh->nodes)
+		return ;
+	stats = &scene->render_state.accel_stats[ACCEL_BVH];
+	stats->build_ms = bvh->build_ms;
+	stats->bytes = bvh_memory_bytes(bvh) + scene_group_bytes(scene);
+}
+
+void	accel_build_grid(t_scene *scene)
+{
+	t_object_ref	*refs;
+	t_grid			*grid;
+	t_accel_stats	*stats;
+	struct timeval	start;
+	int				count;
+
+	if (scene->render_state.grid)
+		return ;
+	timer_start(&start);
+	refs = scene_object_refs(scene, &count);
+	if (!refs)
+		return ;
+	grid = grid_build(refs, count, scene);
+	free(refs);
+	scene->render_state.grid = grid;
+	if (!grid)
+		return ;
+	stats = &scene->render_state.accel_stats[ACCEL_GRID];
+	stats->build_ms = timer_elapsed_ms(&start);
+	stats->bytes = sizeof(t_grid) + grid->ref_count * sizeof(t_object_ref)
+		+ ((size_t)grid->res[0] * grid->res[1] * grid->res[2] + 1)
+		* sizeof(int) + scene_group_bytes(scene);
+}
+
+void	accel_build_octree(t_scene *scene)
+{
+	t_object_ref	*refs;
+	t_octree		*tree;
+	t_accel_stats	*stats;
+	struct timeval	start;
+	int				count;
+
+	if (scene->render_state.octree)
+		return ;
+	timer_start(&start);
+	refs = scene_object_refs(scene, &count);
+	if (!refs)
+		return ;
+	tree = octree_build(refs, count, scene);
+	free(refs);
+	scene->render_state.octree = tree;
+	if (!tree)
+		return ;
+	stats = &scene->render_state.accel_stats[ACCEL_OCTREE];
+	stats->build_ms = timer_elapsed_ms(&start);
+	stats->bytes = sizeof(t_octree) + tree->ref_count * sizeof(t_object_ref)
+		+ tree->node_count * sizeof(t_octree_node) + scene_group_bytes(scene);
+}
+
+/*
+** Place the instances (building their groups' BVHs first), then build
+** the active backend and time it on the probe rays.
+*/
+void	scene_build_accel(t_scene *scene)
+{
+	const t_accel_ops	*ops;
+
+	scene_build_groups(scene);
+	ops = accel_ops(scene->render_state.accel);
+	if (ops->build)
+		ops->build(scene);
+	accel_probe(scene);
+}
+
+/* Switch backends, building the new one on first use */
+void	scene_select_accel(t_scene *scene, int kind)
+{
+	const t_accel_ops	*ops;
+
+	scene->render_state.accel = kind;
+	ops = accel_ops(kind);
+	if (ops->build)
+		ops->build(scene);
+	accel_probe(scene);
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   accel_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:52:16 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 13:52:16 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "window.h"
+#include "accel.h"
+#include <math.h>
+#include <stdio.h>
+
+/*
+** Probe ray i of the ACCEL_PROBE_W x ACCEL_PROBE_H grid: a camera ray
+** through the middle of its patch of the frame and, when it hits, the
+** shadow ray from the hit toward the light.
+** Returns the number of rays traced.
+*/
+static int	probe_ray(t_scene *scene, t_camera_frame *cam, int i)
+{
+	t_ray	ray;
+	t_hit	hit;
+	t_vec3	to_light;
+	t_real	distance;
+
+	ray.origin = cam->origin;
+	ray.direction = vec3_normalize(vec3_add(vec3_add(cam->corner,
+					vec3_multiply(cam->dx, (i % ACCEL_PROBE_W + 0.5)
+						* WINDOW_WIDTH / ACCEL_PROBE_W)),
+				vec3_multiply(cam->dy, (i / ACCEL_PROBE_W + 0.5)
+					* WINDOW_HEIGHT / ACCEL_PROBE_H)));
+	ray_prepare(&ray);
+	hit.distance = INFINITY;
+	if (!accel_intersect(scene, &ray, &hit))
+		return (1);
+	to_light = vec3_subtract(scene->light.position, hit.point);
+	distance = vec3_magnitude(to_light);
+	ray.direction = vec3_normalize(to_light);
+	ray.origin = vec3_add(hit.point, vec3_multiply(ray.direction,
+				RAY_T_MIN));
+	ray_prepare(&ray);
+	accel_occluded(scene, &ray, distance);
+	return (2);
+}
+
+/*
+** Time the active backend on a fixed set of probe rays. Runs on one
+** thread and always traces the same rays, so the figure compares
+** backends (and builder settings) on equal terms for this scene.
+*/
+void	accel_probe(t_scene *scene)
+{
+	t_camera_frame	cam;
+	t_accel_stats	*stats;
+	struct timeval	start;
+	int				i;
+
+	stats = &scene->render_state.accel_stats[scene->render_state.accel];
+	camera_frame_init(&cam, &scene->camera);
+	stats->probe_rays = 0;
+	timer_start(&start);
+	i = 0;
+	while (i < ACCEL_PROBE_W * ACCEL_PROBE_H)
+		stats->probe_rays += probe_ray(scene, &cam, i++);
+	stats->probe_us = timer_elapsed_us(&start) / (double)stats->probe_rays;
+}
+
+void	accel_report_grid(t_scene *scene)
+{
+	t_grid	*grid;
+
+	grid = scene->render_state.grid;
+	if (!grid)
+		return ;
+	printf("Grid: %d objects, %dx%dx%d cells, %d refs (%.2f per object), "
+		"built in %.2f ms\n", grid->object_count, grid->res[0], grid->res[1],
+		grid->res[2], grid->ref_count,
+		grid->ref_count / (double)grid->object_count,
+		scene->render_state.accel_stats[ACCEL_GRID].build_ms);
+}
+
+void	accel_report_octree(t_scene *scene)
+{
+	t_octree	*tree;
+
+	tree = scene->render_state.octree;
+	if (!tree)
+		return ;
+	printf("Octree: %d objects, %d nodes, %d leaves, depth %d, %d refs "
+		"(%.2f per object), built in %.2f ms\n", tree->object_count,
+		tree->node_count, tree->leaves, tree->depth, tree->ref_count,
+		tree->ref_count / (double)tree->object_count,
+		scene->render_state.accel_stats[ACCEL_OCTREE].build_ms);
+}
+
+/*
+** With --bvh-stats: the backend's own line, the instancing summary,
+** then one line every backend shares: memory held and the mean probe
+** ray cost, the figure to compare when picking a backend for a scene.
+** Without it nothing is printed; the HUD still shows the figures.
+*/
+void	scene_report_accel(t_scene *scene)
+{
+	const t_accel_ops	*ops;
+	t_accel_stats		*stats;
+
+	if (!scene->render_state.bvh_config.stats)
+		return ;
+	ops = accel_ops(scene->render_state.accel);
+	stats = &scene->render_state.accel_stats[scene->render_state.accel];
+	if (ops->report)
+		ops->report(scene);
+	scene_report_instances(scene);
+	printf("Accel: %s, %.2f MB, probe %.3f us/ray over %ld rays\n",
+		ops->name, stats->bytes / (1024.0 * 1024.0), stats->probe_us,
+		stats->probe_rays);
+	fflush(stdout);
+}
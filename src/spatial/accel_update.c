@@ -0,0 +1,56 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   accel_update.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:44:27 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 13:44:27 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "window.h"
+#include "accel.h"
+
+/*
+** An object moved: flag its BVH leaf for the refit and mark grid and
+** octree out of date. Planes are in neither, so they only reach the
+** BVH call, which ignores them.
+*/
+void	accel_mark_dirty(t_scene *scene, t_object_ref ref)
+{
+	bvh_mark_dirty(scene->render_state.bvh, ref);
+	if (ref.type != OBJ_PLANE)
+		scene->render_state.accel_stale = 1;
+}
+
+/* Free grid and octree; they are rebuilt when next selected */
+void	accel_release(t_scene *scene)
+{
+	grid_destroy(scene->render_state.grid);
+	scene->render_state.grid = NULL;
+	octree_destroy(scene->render_state.octree);
+	scene->render_state.octree = NULL;
+}
+
+/*
+** Before each frame: refit the BVH (or rebuild it, scene_update_bvh)
+** and rebuild a stale grid or octree from scratch, which is cheap
+** next to a frame. Only the active one is rebuilt; the other is
+** dropped until it is selected again.
+*/
+void	scene_update_accel(t_scene *scene)
+{
+	const t_accel_ops	*ops;
+
+	scene_update_bvh(scene);
+	if (!scene->render_state.accel_stale)
+		return ;
+	scene->render_state.accel_stale = 0;
+	accel_release(scene);
+	ops = accel_ops(scene->render_state.accel);
+	if (ops->build)
+		ops->build(scene);
+}
@@ -14,6 +14,46 @@
 #include "minirt.h"
 #include "window.h"
 
+static float	min3(float a, float b, float c)
+{
+	if (b < a)
+		a = b;
+	if (c < a)
+		a = c;
+	return (a);
+}
+
+static float	max3(float a, float b, float c)
+{
+	if (b > a)
+		a = b;
+	if (c > a)
+		a = c;
+	return (a);
+}
+
+/*
+** Box around the three vertices of mesh triangle index. Called for
+** every triangle at every level of the build, so it works on the
+** single precision vertices directly.
+*/
+static t_aabb	triangle_bounds(t_scene *scene, int index)
+{
+	t_vertex	*v[3];
+	t_aabb		box;
+
+	v[0] = &scene->vertices[scene->triangles[index].v[0]];
+	v[1] = &scene->vertices[scene->triangles[index].v[1]];
+	v[2] = &scene->vertices[scene->triangles[index].v[2]];
+	box.min.x = min3(v[0]->x, v[1]->x, v[2]->x);
+	box.min.y = min3(v[0]->y, v[1]->y, v[2]->y);
+	box.min.z = min3(v[0]->z, v[1]->z, v[2]->z);
+	box.max.x = max3(v[0]->x, v[1]->x, v[2]->x);
+	box.max.y = max3(v[0]->y, v[1]->y, v[2]->y);
+	box.max.z = max3(v[0]->z, v[1]->z, v[2]->z);
+	return (box);
+}
+
 t_aabb	get_object_bounds(t_object_ref ref, void *scene_ptr)
 {
 	t_scene	*scene;
@@ -27,6 +67,11 @@ t_aabb	get_object_bounds(t_object_ref ref, void *scene_ptr)
 				scene->cylinders[ref.index].axis,
 				scene->cylinders[ref.index].radius,
 				scene->cylinders[ref.index].height));
+	else if (ref.type == OBJ_INSTANCE)
+		return (aabb_create(scene->instances[ref.index].box_min,
+				scene->instances[ref.index].box_max));
+	else if (ref.type == OBJ_TRIANGLE)
+		return (triangle_bounds(scene, ref.index));
 	else
 		return (aabb_for_plane(scene->planes[ref.index].point,
 				scene->planes[ref.index].normal));
@@ -35,12 +80,21 @@ t_aabb	get_object_bounds(t_object_ref ref, void *scene_ptr)
 t_vec3	get_object_center(t_object_ref ref, void *scene_ptr)
 {
 	t_scene	*scene;
+	t_aabb	box;
 
 	scene = (t_scene *)scene_ptr;
 	if (ref.type == OBJ_SPHERE)
 		return (scene->spheres[ref.index].center);
 	else if (ref.type == OBJ_CYLINDER)
 		return (scene->cylinders[ref.index].center);
+	else if (ref.type == OBJ_INSTANCE)
+		return (vec3_multiply(vec3_add(scene->instances[ref.index].box_min,
+					scene->instances[ref.index].box_max), 0.5));
+	else if (ref.type == OBJ_TRIANGLE)
+	{
+		box = triangle_bounds(scene, ref.index);
+		return (vec3_multiply(vec3_add(box.min, box.max), 0.5));
+	}
 	else
 		return (scene->planes[ref.index].point);
 }
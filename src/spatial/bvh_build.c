@@ -12,6 +12,7 @@
 
 #include "spatial.h"
 #include "minirt.h"
+#include "metrics.h"
 #include <stdlib.h>
 
 t_bvh	*bvh_create(void)
@@ -21,10 +22,30 @@ t_bvh	*bvh_create(void)
 	bvh = malloc(sizeof(t_bvh));
 	if (!bvh)
 		return (NULL);
-	bvh->root = NULL;
+	bvh->nodes = NULL;
+	bvh->prims = NULL;
+	bvh->prim_leaf = NULL;
+	bvh->slot = NULL;
+	bvh->dirty = NULL;
+	bvh->dirty_count = 0;
+	bvh->build_cost = 0;
+	bvh->build_ms = 0;
+	bvh->wide = NULL;
+	bvh->wide_count = 0;
+	bvh->wide_bytes = 0;
+	bvh->map = NULL;
+	bvh->map_size = 0;
+	bvh->cached = 0;
 	bvh->enabled = 1;
 	bvh->total_nodes = 0;
+	bvh->prim_count = 0;
 	bvh->max_depth = 0;
+	bvh->config.builder = BVH_BUILDER_SAH;
+	bvh->config.traversal = BVH_TRAVERSAL_ORDERED;
+	bvh->config.width = BVH_DEFAULT_WIDTH;
+	bvh->config.threads = 0;
+	bvh->config.cache = 0;
+	bvh->config.stats = 0;
 	return (bvh);
 }
 
@@ -43,11 +64,11 @@ void	bvh_destroy(t_bvh *bvh)
 {
 	if (!bvh)
 		return ;
-	bvh_node_destroy(bvh->root);
+	bvh_clear_arrays(bvh);
 	free(bvh);
 }
 
-static t_aabb	compute_bounds(t_object_ref *objects, int count, void *scene)
+t_aabb	bvh_compute_bounds(t_object_ref *objects, int count, void *scene)
 {
 	t_aabb	bounds;
 	t_aabb	obj_bounds;
@@ -71,7 +92,7 @@ static t_aabb	compute_bounds(t_object_ref *objects, int count, void *scene)
 }
 
 static int	partition_objects(t_object_ref *objects, int count, int axis,
-		double split, void *scene)
+		t_real split, void *scene)
 {
 	int				i;
 	int				left_count;
@@ -98,8 +119,7 @@ static int	partition_objects(t_object_ref *objects, int count, int axis,
 	return (left_count);
 }
 
-static t_bvh_node	*create_leaf_node(t_object_ref *objects, int count,
-		void *scene)
+t_bvh_node	*bvh_create_leaf(t_object_ref *objects, int count, void *scene)
 {
 	t_bvh_node	*node;
 	int			i;
@@ -107,9 +127,10 @@ static t_bvh_node	*create_leaf_node(t_object_ref *objects, int count,
 	node = malloc(sizeof(t_bvh_node));
 	if (!node)
 		return (NULL);
-	node->bounds = compute_bounds(objects, count, scene);
+	node->bounds = bvh_compute_bounds(objects, count, scene);
 	node->left = NULL;
 	node->right = NULL;
+	node->axis = 0;
 	node->object_count = count;
 	node->objects = malloc(sizeof(t_object_ref) * count);
 	if (!node->objects)
@@ -126,18 +147,21 @@ static t_bvh_node	*create_leaf_node(t_object_ref *objects, int count,
 	return (node);
 }
 
-t_bvh_node	*bvh_build_recursive(t_object_ref *objects, int count,
-		void *scene, int depth)
+/*
+** Midpoint builder: split at the middle of the longest axis.
+** Kept selectable (--bvh-builder midpoint) to compare against SAH.
+*/
+t_bvh_node	*bvh_build_recursive(t_bvh_task *task)
 {
 	t_bvh_node	*node;
 	t_aabb		bounds;
 	int			axis;
-	double		split;
+	t_real		split;
 	int			mid;
 
-	if (count <= 2 || depth > 20)
-		return (create_leaf_node(objects, count, scene));
-	bounds = compute_bounds(objects, count, scene);
+	if (task->count <= 2 || task->depth > BVH_MAX_DEPTH)
+		return (bvh_create_leaf(task->objects, task->count, task->scene));
+	bounds = bvh_compute_bounds(task->objects, task->count, task->scene);
 	axis = 0;
 	if (bounds.max.y - bounds.min.y > bounds.max.x - bounds.min.x)
 		axis = 1;
@@ -147,25 +171,44 @@ t_bvh_node	*bvh_build_recursive(t_object_ref *objects, int count,
 	split = (axis == 0 ? (bounds.min.x + bounds.max.x) / 2.0 : (axis == 1
 				? (bounds.min.y + bounds.max.y) / 2.0 : (bounds.min.z
 					+ bounds.max.z) / 2.0));
-	mid = partition_objects(objects, count, axis, split, scene);
+	mid = partition_objects(task->objects, task->count, axis, split,
+			task->scene);
 	node = malloc(sizeof(t_bvh_node));
 	if (!node)
 		return (NULL);
 	node->bounds = bounds;
+	node->axis = axis;
 	node->objects = NULL;
 	node->object_count = 0;
-	node->left = bvh_build_recursive(objects, mid, scene, depth + 1);
-	node->right = bvh_build_recursive(objects + mid, count - mid, scene,
-			depth + 1);
+	bvh_build_children(node, task, mid);
 	return (node);
 }
 
+/*
+** Build the tree with the selected builder, then replace the BVH's
+** node array with its flattened form. The tree is freed afterwards.
+** Its SAH cost is kept as the baseline for later refits, and the
+** wide tree, if any, is collapsed from it. build_ms covers all of it.
+*/
 void	bvh_build(t_bvh *bvh, t_object_ref *objects, int count, void *scene)
 {
+	t_bvh_node		*root;
+	t_bvh_task		task;
+	struct timeval	start;
+	int				threads;
+
 	if (!bvh || count == 0)
 		return ;
-	if (bvh->root)
-		bvh_node_destroy(bvh->root);
-	bvh->root = bvh_build_recursive(objects, count, scene, 0);
-	bvh->total_nodes = 1;
+	timer_start(&start);
+	threads = bvh_build_threads(bvh->config.threads);
+	task = (t_bvh_task){objects, count, scene, 0, 0, bvh->config.builder};
+	while (threads > 1 && (1 << task.forks) < threads * 2
+		&& task.forks < BVH_MAX_FORKS)
+		task.forks++;
+	root = bvh_build_subtree(&task);
+	bvh_flatten(bvh, root);
+	bvh_node_destroy(root);
+	bvh->build_cost = bvh_sah_cost(bvh);
+	bvh_wide_build(bvh);
+	bvh->build_ms = timer_elapsed_ms(&start);
 }
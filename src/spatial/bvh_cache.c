@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_cache.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/18 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/18 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include "minirt.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* FNV-1a over size bytes of data */
+static uint64_t	hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+	const unsigned char	*byte;
+
+	byte = data;
+	while (size-- > 0)
+	{
+		hash ^= *byte++;
+		hash *= 1099511628211ULL;
+	}
+	return (hash);
+}
+
+/*
+** The cache key hashes everything the builder reads: object order,
+** bounds and centers, the builder and the size of t_real. A file
+** whose key does not match is ignored and overwritten by the next
+** build.
+*/
+uint64_t	bvh_scene_hash(t_object_ref *refs, int count, void *scene,
+		int builder)
+{
+	uint64_t	hash;
+	int			key[4];
+	t_aabb		box;
+	t_vec3		center;
+
+	key[0] = BVH_CACHE_VERSION;
+	key[1] = (int)sizeof(t_real);
+	key[2] = builder;
+	key[3] = count;
+	hash = hash_bytes(14695981039346656037ULL, key, sizeof(key));
+	while (count-- > 0)
+	{
+		box = get_object_bounds(*refs, scene);
+		center = get_object_center(*refs, scene);
+		hash = hash_bytes(hash, refs++, sizeof(t_object_ref));
+		hash = hash_bytes(hash, &box, sizeof(box));
+		hash = hash_bytes(hash, &center, sizeof(center));
+	}
+	return (hash);
+}
+
+/* "<scene_file>.bvh", or NULL if out of memory */
+char	*bvh_cache_path(const char *scene_file)
+{
+	char	*path;
+	size_t	size;
+
+	size = strlen(scene_file) + 5;
+	path = malloc(size);
+	if (path)
+		snprintf(path, size, "%s.bvh", scene_file);
+	return (path);
+}
+
+void	bvh_cache_unmap(t_bvh *bvh)
+{
+	if (!bvh->map)
+		return ;
+	munmap(bvh->map, bvh->map_size);
+	bvh->map = NULL;
+	bvh->map_size = 0;
+	bvh->cached = 0;
+	bvh->nodes = NULL;
+	bvh->prims = NULL;
+}
+
+static int	write_all(int fd, const void *data, size_t size)
+{
+	const char	*byte;
+	ssize_t		written;
+
+	byte = data;
+	while (size > 0)
+	{
+		written = write(fd, byte, size);
+		if (written <= 0)
+			return (0);
+		byte += written;
+		size -= written;
+	}
+	return (1);
+}
+
+static int	write_cache(int fd, t_bvh *bvh, uint64_t hash)
+{
+	t_bvh_cache_header	header;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, BVH_CACHE_MAGIC, sizeof(header.magic));
+	header.hash = hash;
+	header.version = BVH_CACHE_VERSION;
+	header.total_nodes = bvh->total_nodes;
+	header.prim_count = bvh->prim_count;
+	header.max_depth = bvh->max_depth;
+	header.build_cost = bvh->build_cost;
+	return (write_all(fd, &header, sizeof(header))
+		&& write_all(fd, bvh->nodes, sizeof(t_bvh_flat_node)
+			* bvh->total_nodes)
+		&& write_all(fd, bvh->prims, sizeof(t_object_ref) * bvh->prim_count));
+}
+
+/*
+** Write the freshly built tree to path. The file is written under a
+** temporary name and renamed into place, so a reader never maps a
+** half-written cache. A failure only costs the next launch a rebuild.
+*/
+void	bvh_cache_save(t_bvh *bvh, const char *path, uint64_t hash)
+{
+	char	*tmp;
+	int		fd;
+	int		ok;
+
+	tmp = malloc(strlen(path) + 5);
+	if (!tmp || !bvh->nodes)
+	{
+		free(tmp);
+		return ;
+	}
+	snprintf(tmp, strlen(path) + 5, "%s.tmp", path);
+	ok = 0;
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd >= 0)
+	{
+		ok = write_cache(fd, bvh, hash);
+		ok = (close(fd) == 0) && ok && rename(tmp, path) == 0;
+	}
+	if (!ok)
+	{
+		unlink(tmp);
+		fprintf(stderr, "Warning: could not write BVH cache %s\n", path);
+	}
+	free(tmp);
+}
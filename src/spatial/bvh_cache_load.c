@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_cache_load.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/18 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/18 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include "minirt.h"
+#include "window.h"
+#include "metrics.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Map path privately (copy-on-write); returns 0 if it cannot be read */
+static int	map_file(const char *path, void **map, size_t *size)
+{
+	struct stat	st;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (0);
+	*map = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(
+			t_bvh_cache_header))
+	{
+		*size = st.st_size;
+		*map = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	return (*map != MAP_FAILED);
+}
+
+static int	header_matches(t_bvh_cache_header *header, size_t size,
+		uint64_t hash)
+{
+	return (memcmp(header->magic, BVH_CACHE_MAGIC, sizeof(header->magic)) == 0
+		&& header->version == BVH_CACHE_VERSION && header->hash == hash
+		&& header->total_nodes > 0 && header->prim_count > 0
+		&& size == sizeof(t_bvh_cache_header) + sizeof(t_bvh_flat_node)
+		* (size_t)header->total_nodes + sizeof(t_object_ref)
+		* (size_t)header->prim_count);
+}
+
+static int	valid_ref(t_object_ref ref, t_scene *scene)
+{
+	if (ref.type == OBJ_SPHERE)
+		return (ref.index >= 0 && ref.index < scene->sphere_count);
+	if (ref.type == OBJ_CYLINDER)
+		return (ref.index >= 0 && ref.index < scene->cylinder_count);
+	if (ref.type == OBJ_INSTANCE)
+		return (ref.index >= 0 && ref.index < scene->instance_count);
+	if (ref.type == OBJ_TRIANGLE)
+		return (ref.index >= 0 && ref.index < scene->triangle_count);
+	return (0);
+}
+
+/*
+** The hash only covers the scene, so check that the mapped tree is
+** walkable before trusting it: child and leaf ranges stay inside the
+** arrays, leaves cover every object once and every object reference
+** exists. Fills prim_leaf on the way; check_depth bounds the depth.
+*/
+static int	check_tree(t_bvh *bvh, t_scene *scene)
+{
+	t_bvh_flat_node	*node;
+	int				covered;
+	int				i;
+
+	covered = 0;
+	i = -1;
+	while (++i < bvh->total_nodes)
+	{
+		node = &bvh->nodes[i];
+		if (node->count == 0 && (node->offset <= i + 1
+				|| node->offset >= bvh->total_nodes))
+			return (0);
+		if (node->count > 0 && (node->offset != covered
+				|| (int)node->count > bvh->prim_count - covered))
+			return (0);
+		while (node->count > 0 && covered < node->offset + (int)node->count)
+			bvh->prim_leaf[covered++] = i;
+	}
+	i = 0;
+	while (i < bvh->prim_count && valid_ref(bvh->prims[i], scene))
+		i++;
+	return (covered == bvh->prim_count && i == bvh->prim_count);
+}
+
+/*
+** Children always follow their parent in the node array, so one
+** forward pass gives every node its longest path from the root. The
+** binary and wide walks size their stacks for BVH_MAX_DEPTH, so a
+** deeper tree, or one whose depth disagrees with the header, is
+** rejected.
+*/
+static int	check_depth(t_bvh *bvh)
+{
+	t_bvh_flat_node	*node;
+	int				*depth;
+	int				deepest;
+	int				i;
+
+	depth = calloc(bvh->total_nodes, sizeof(int));
+	if (!depth)
+		return (0);
+	deepest = 0;
+	i = -1;
+	while (++i < bvh->total_nodes)
+	{
+		node = &bvh->nodes[i];
+		if (depth[i] > deepest)
+			deepest = depth[i];
+		if (node->count == 0 && depth[i + 1] < depth[i] + 1)
+			depth[i + 1] = depth[i] + 1;
+		if (node->count == 0 && depth[node->offset] < depth[i] + 1)
+			depth[node->offset] = depth[i] + 1;
+	}
+	free(depth);
+	return (deepest <= BVH_MAX_DEPTH + 1 && deepest == bvh->max_depth);
+}
+
+static void	adopt_map(t_bvh *bvh, void *map, size_t size)
+{
+	t_bvh_cache_header	*header;
+
+	header = map;
+	bvh->map = map;
+	bvh->map_size = size;
+	bvh->cached = 1;
+	bvh->nodes = (t_bvh_flat_node *)(header + 1);
+	bvh->prims = (t_object_ref *)(bvh->nodes + header->total_nodes);
+	bvh->total_nodes = header->total_nodes;
+	bvh->prim_count = header->prim_count;
+	bvh->max_depth = header->max_depth;
+	bvh->build_cost = header->build_cost;
+}
+
+/*
+** Replace bvh's tree with the one cached at path if its key is hash.
+** Returns 0 (leaving the BVH empty) on a miss or a damaged file, in
+** which case the caller builds the tree instead.
+*/
+int	bvh_cache_load(t_bvh *bvh, const char *path, uint64_t hash,
+		t_scene *scene)
+{
+	struct timeval	start;
+	void			*map;
+	size_t			size;
+
+	timer_start(&start);
+	if (!map_file(path, &map, &size))
+		return (0);
+	if (!header_matches(map, size, hash))
+	{
+		munmap(map, size);
+		return (0);
+	}
+	bvh_clear_arrays(bvh);
+	adopt_map(bvh, map, size);
+	bvh->prim_leaf = malloc(sizeof(int) * bvh->prim_count);
+	bvh->dirty = calloc(bvh->total_nodes, 1);
+	if (!bvh->prim_leaf || !bvh->dirty || !check_tree(bvh, scene)
+		|| !check_depth(bvh) || !bvh_index_slots(bvh))
+		return (bvh_clear_arrays(bvh));
+	bvh_wide_build(bvh);
+	bvh->build_ms = timer_elapsed_ms(&start);
+	return (1);
+}
@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_flatten.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/12 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/12 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(t_bvh_flat_node) == 32, "BVH node must be 32 bytes");
+
+/*
+** Count nodes and leaf objects of a tree and record its depth.
+** Returns 0 if an inner node lost a child (allocation failure).
+*/
+static int	measure_tree(t_bvh_node *node, int depth, t_bvh *bvh)
+{
+	if (!node)
+		return (0);
+	bvh->total_nodes++;
+	if (depth > bvh->max_depth)
+		bvh->max_depth = depth;
+	if (node->object_count > 0)
+	{
+		bvh->prim_count += node->object_count;
+		return (1);
+	}
+	return (measure_tree(node->left, depth + 1, bvh)
+		&& measure_tree(node->right, depth + 1, bvh));
+}
+
+/* Round one bound to float, away from the box interior */
+static float	round_bound(t_real value, float direction)
+{
+	float	rounded;
+
+	rounded = (float)value;
+	if ((direction < 0 && rounded > value)
+		|| (direction > 0 && rounded < value))
+		rounded = nextafterf(rounded, direction);
+	return (rounded);
+}
+
+/* Store box in a flat node, rounded outward to single precision */
+void	bvh_flat_store_bounds(t_bvh_flat_node *flat, t_aabb box)
+{
+	flat->min[0] = round_bound(box.min.x, -INFINITY);
+	flat->min[1] = round_bound(box.min.y, -INFINITY);
+	flat->min[2] = round_bound(box.min.z, -INFINITY);
+	flat->max[0] = round_bound(box.max.x, INFINITY);
+	flat->max[1] = round_bound(box.max.y, INFINITY);
+	flat->max[2] = round_bound(box.max.z, INFINITY);
+}
+
+/*
+** Append node and its subtree in depth-first order; leaf objects are
+** appended to prims (and their leaf to prim_leaf; bvh_index_slots
+** indexes them by object once the tree is done). Returns the node's
+** index.
+*/
+static int	flatten_node(t_bvh *bvh, t_bvh_node *node, int *prim_next)
+{
+	t_bvh_flat_node	*flat;
+	int				index;
+	int				i;
+
+	index = bvh->total_nodes++;
+	flat = &bvh->nodes[index];
+	bvh_flat_store_bounds(flat, node->bounds);
+	flat->count = node->object_count;
+	flat->axis = node->axis;
+	if (node->object_count > 0)
+	{
+		flat->offset = *prim_next;
+		i = 0;
+		while (i < node->object_count)
+		{
+			bvh->prim_leaf[*prim_next] = index;
+			bvh->prims[(*prim_next)++] = node->objects[i++];
+		}
+		return (index);
+	}
+	flatten_node(bvh, node->left, prim_next);
+	flat->offset = flatten_node(bvh, node->right, prim_next);
+	return (index);
+}
+
+/*
+** Release the BVH's arrays (or its cache mapping) and leave it empty.
+** Always returns 0 so failure paths can return it directly.
+*/
+int	bvh_clear_arrays(t_bvh *bvh)
+{
+	bvh_cache_unmap(bvh);
+	free(bvh->nodes);
+	free(bvh->prims);
+	free(bvh->prim_leaf);
+	free(bvh->slot);
+	free(bvh->dirty);
+	bvh_wide_clear(bvh);
+	bvh->nodes = NULL;
+	bvh->prims = NULL;
+	bvh->prim_leaf = NULL;
+	bvh->slot = NULL;
+	memset(bvh->slot_base, 0, sizeof(bvh->slot_base));
+	bvh->dirty = NULL;
+	bvh->dirty_count = 0;
+	bvh->total_nodes = 0;
+	bvh->prim_count = 0;
+	bvh->max_depth = 0;
+	return (0);
+}
+
+/*
+** Replace bvh's node and object arrays with the flattened tree.
+** Returns 1 on success; on failure the BVH is left empty.
+*/
+int	bvh_flatten(t_bvh *bvh, t_bvh_node *root)
+{
+	int	prim_next;
+
+	bvh_clear_arrays(bvh);
+	if (!measure_tree(root, 0, bvh))
+		return (bvh_clear_arrays(bvh));
+	bvh->nodes = malloc(sizeof(t_bvh_flat_node) * bvh->total_nodes);
+	bvh->prims = malloc(sizeof(t_object_ref) * bvh->prim_count);
+	bvh->prim_leaf = malloc(sizeof(int) * bvh->prim_count);
+	bvh->dirty = calloc(bvh->total_nodes, 1);
+	if (!bvh->nodes || !bvh->prims || !bvh->prim_leaf || !bvh->dirty)
+		return (bvh_clear_arrays(bvh));
+	bvh->total_nodes = 0;
+	prim_next = 0;
+	flatten_node(bvh, root, &prim_next);
+	if (!bvh_index_slots(bvh))
+		return (bvh_clear_arrays(bvh));
+	return (1);
+}
+
+t_aabb	bvh_flat_bounds(const t_bvh_flat_node *node)
+{
+	t_aabb	box;
+
+	box.min.x = node->min[0];
+	box.min.y = node->min[1];
+	box.min.z = node->min[2];
+	box.max.x = node->max[0];
+	box.max.y = node->max[1];
+	box.max.z = node->max[2];
+	return (box);
+}
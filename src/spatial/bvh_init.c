@@ -13,43 +13,84 @@
 #include "spatial.h"
 #include "minirt.h"
 #include "window.h"
+#include <stdio.h>
 #include <stdlib.h>
 
+/*
+** Only bounded objects go into the accelerators. A plane's box spans
+** the whole world and would make every ancestor useless for culling,
+** so planes are tested in their own loop (intersect_planes) instead.
+** Instances enter as one reference each; their groups have trees of
+** their own, which is where mesh triangles live.
+*/
 static int	count_objects(t_scene *scene)
 {
-	return (scene->sphere_count + scene->plane_count + scene->cylinder_count);
+	return (scene->sphere_count + scene->cylinder_count
+		+ scene->instance_count + scene->triangle_count);
 }
 
-static void	fill_object_refs(t_scene *scene, t_object_ref *refs)
+/* Append references to objects 0 .. count - 1 of type at refs + idx */
+static int	fill_type(t_object_ref *refs, int idx, int type, int count)
 {
 	int	i;
-	int	idx;
 
-	idx = 0;
 	i = 0;
-	while (i < scene->sphere_count)
+	while (i < count)
 	{
-		refs[idx].type = OBJ_SPHERE;
+		refs[idx].type = type;
 		refs[idx].index = i;
 		idx++;
 		i++;
 	}
-	i = 0;
-	while (i < scene->plane_count)
-	{
-		refs[idx].type = OBJ_PLANE;
-		refs[idx].index = i;
-		idx++;
-		i++;
-	}
-	i = 0;
-	while (i < scene->cylinder_count)
+	return (idx);
+}
+
+/*
+** References to every bounded object, in a fresh array the caller
+** frees. Returns NULL (count 0) when there are none or on allocation
+** failure.
+*/
+t_object_ref	*scene_object_refs(t_scene *scene, int *count)
+{
+	t_object_ref	*refs;
+	int				idx;
+
+	*count = count_objects(scene);
+	refs = NULL;
+	if (*count > 0)
+		refs = malloc(sizeof(t_object_ref) * *count);
+	if (!refs)
 	{
-		refs[idx].type = OBJ_CYLINDER;
-		refs[idx].index = i;
-		idx++;
-		i++;
+		*count = 0;
+		return (NULL);
 	}
+	idx = fill_type(refs, 0, OBJ_SPHERE, scene->sphere_count);
+	idx = fill_type(refs, idx, OBJ_CYLINDER, scene->cylinder_count);
+	idx = fill_type(refs, idx, OBJ_INSTANCE, scene->instance_count);
+	fill_type(refs, idx, OBJ_TRIANGLE, scene->triangle_count);
+	return (refs);
+}
+
+/*
+** Build the tree, or with a cache path map it from the sidecar file
+** when that was written for the same objects. A fresh build is then
+** saved for the next launch.
+*/
+static void	load_or_build(t_bvh *bvh, t_object_ref *refs, int count,
+		t_scene *scene)
+{
+	const char	*cache;
+	uint64_t	hash;
+
+	cache = scene->render_state.bvh_cache;
+	hash = 0;
+	if (cache)
+		hash = bvh_scene_hash(refs, count, scene, bvh->config.builder);
+	if (cache && bvh_cache_load(bvh, cache, hash, scene))
+		return ;
+	bvh_build(bvh, refs, count, scene);
+	if (cache)
+		bvh_cache_save(bvh, cache, hash);
 }
 
 void	scene_build_bvh(t_scene *scene)
@@ -57,18 +98,65 @@ void	scene_build_bvh(t_scene *scene)
 	t_object_ref	*refs;
 	int				total_objects;
 
-	if (!scene->render_state.bvh_enabled)
-		return ;
-	total_objects = count_objects(scene);
-	if (total_objects == 0)
-		return ;
-	refs = malloc(sizeof(t_object_ref) * total_objects);
+	refs = scene_object_refs(scene, &total_objects);
 	if (!refs)
 		return ;
-	fill_object_refs(scene, refs);
 	if (!scene->render_state.bvh)
 		scene->render_state.bvh = bvh_create();
 	if (scene->render_state.bvh)
-		bvh_build(scene->render_state.bvh, refs, total_objects, scene);
+		scene->render_state.bvh->config = scene->render_state.bvh_config;
+	if (scene->render_state.bvh)
+		load_or_build(scene->render_state.bvh, refs, total_objects, scene);
+	if (scene->render_state.bvh)
+		bvh_compute_stats(scene->render_state.bvh);
 	free(refs);
 }
+
+/*
+** Bring the BVH up to date after objects moved (bvh_mark_dirty):
+** refit the touched nodes, or rebuild from scratch once refitting
+** has degraded the tree past BVH_REFIT_MAX_GROWTH. A refit updates
+** the SAH and overlap figures itself; a rebuild recomputes all stats.
+** Moved objects no longer match the file, so the cache is dropped for
+** the rest of the session instead of being rewritten on every rebuild.
+*/
+void	scene_update_bvh(t_scene *scene)
+{
+	t_bvh	*bvh;
+
+	bvh = scene->render_state.bvh;
+	if (!bvh || bvh->dirty_count == 0)
+		return ;
+	free(scene->render_state.bvh_cache);
+	scene->render_state.bvh_cache = NULL;
+	if (bvh_refit(bvh, scene))
+		scene_build_bvh(scene);
+}
+
+/*
+** With --bvh-stats, one line after the initial build (tree size, SAH
+** cost and build time, or the load time when it came from the cache)
+** so builders and thread counts can be compared on a given scene,
+** then the full quality dump. Without it nothing is printed.
+*/
+void	scene_report_bvh(t_scene *scene)
+{
+	t_bvh		*bvh;
+	const char	*builder;
+
+	bvh = scene->render_state.bvh;
+	if (!bvh || !bvh->nodes || !bvh->config.stats)
+		return ;
+	printf("BVH: %d objects, %d nodes, depth %d, SAH cost %.2f, ",
+		bvh->prim_count, bvh->total_nodes, bvh->max_depth, bvh->build_cost);
+	builder = "sah";
+	if (bvh->config.builder == BVH_BUILDER_MIDPOINT)
+		builder = "midpoint";
+	if (bvh->cached)
+		printf("loaded from %s in %.2f ms\n", scene->render_state.bvh_cache,
+			bvh->build_ms);
+	else
+		printf("built in %.2f ms (%s, threads %d)\n", bvh->build_ms,
+			builder, bvh_build_threads(bvh->config.threads));
+	bvh_print_stats(bvh);
+}
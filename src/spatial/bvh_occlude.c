@@ -0,0 +1,138 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_occlude.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:05:31 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 14:05:31 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include "minirt.h"
+#include "window.h"
+#include "ray.h"
+
+/*
+** Any-hit test of one object for shadow rays: 1 if it is hit within
+** [RAY_T_MIN, max_distance]. Only the distance is solved; no point,
+** normal or color is computed.
+*/
+int	bvh_occlude_object(t_object_ref ref, t_ray *ray, t_real max_distance,
+		void *scene_ptr)
+{
+	t_scene	*scene;
+	t_hit	hit;
+
+	scene = (t_scene *)scene_ptr;
+	if (ref.type == OBJ_SPHERE)
+		return (sphere_occludes(ray, &scene->spheres[ref.index],
+				max_distance));
+	else if (ref.type == OBJ_CYLINDER)
+		return (cylinder_occludes(ray, &scene->cylinders[ref.index],
+				max_distance));
+	else if (ref.type == OBJ_INSTANCE)
+		return (instance_occludes(scene, &scene->instances[ref.index], ray,
+				max_distance));
+	else if (ref.type == OBJ_TRIANGLE)
+		return (triangle_occludes(ray, scene, ref.index, max_distance));
+	hit.distance = max_distance;
+	return (bvh_intersect_object(ref, ray, &hit, scene));
+}
+
+/* Box test of node over [RAY_T_MIN, max_distance] */
+static int	bvh_box_within(t_bvh_flat_node *node, t_ray *ray,
+		t_real max_distance)
+{
+	t_aabb	box;
+	t_real	t_range[2];
+
+	box = bvh_flat_bounds(node);
+	t_range[0] = RAY_T_MIN;
+	t_range[1] = max_distance;
+	return (aabb_intersect(&box, ray, &t_range[0], &t_range[1]));
+}
+
+/* 1 as soon as one of the leaf's objects blocks the ray */
+static int	bvh_leaf_occluded(t_bvh *bvh, t_bvh_flat_node *node,
+		t_ray *ray, t_real max_distance, void *scene)
+{
+	int	i;
+
+	i = 0;
+	while (i < (int)node->count)
+	{
+		if (bvh_occlude_object(bvh->prims[node->offset + i], ray,
+				max_distance, scene))
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/* Children of inner node index, nearer child last so it is popped first */
+static void	bvh_push_pair(t_bvh_flat_node *node, int index, t_ray *ray,
+		int *slot)
+{
+	slot[0] = node->offset;
+	slot[1] = index + 1;
+	if (ray->sign[node->axis])
+	{
+		slot[0] = index + 1;
+		slot[1] = node->offset;
+	}
+}
+
+/*
+** Any-hit walk of the binary tree. The limit never shrinks, so child
+** order only decides which occluder is found first; the nearer child
+** is still popped first, as in the closest-hit walk.
+*/
+static int	bvh_binary_occluded(t_bvh *bvh, t_ray *ray, t_real max_distance,
+		void *scene)
+{
+	int				stack[BVH_STACK_SIZE];
+	t_bvh_flat_node	*node;
+	int				top;
+	int				index;
+
+	stack[0] = 0;
+	top = 1;
+	while (top > 0)
+	{
+		index = stack[--top];
+		node = &bvh->nodes[index];
+		if (bvh_box_within(node, ray, max_distance))
+		{
+			if (node->count > 0
+				&& bvh_leaf_occluded(bvh, node, ray, max_distance, scene))
+				return (1);
+			if (node->count == 0)
+			{
+				bvh_push_pair(node, index, ray, stack + top);
+				top += 2;
+			}
+		}
+	}
+	return (0);
+}
+
+/*
+** 1 if any of the BVH's objects lies within [RAY_T_MIN, max_distance]
+** along ray, stopping at the first one found; ray must have been
+** through ray_prepare. Shadow rays only need that answer, so unlike
+** bvh_intersect nothing is kept sorted by distance and no hit record
+** is filled.
+*/
+int	bvh_occluded(t_bvh *bvh, t_ray ray, t_real max_distance, void *scene)
+{
+	if (!bvh || !bvh->nodes || !bvh->enabled)
+		return (0);
+	if (bvh->wide && bvh->config.width == 8)
+		return (bvh_wide8_occluded(bvh, ray, max_distance, scene));
+	if (bvh->wide && bvh->config.width == 4)
+		return (bvh_wide4_occluded(bvh, ray, max_distance, scene));
+	return (bvh_binary_occluded(bvh, &ray, max_distance, scene));
+}
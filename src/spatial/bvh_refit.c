@@ -0,0 +1,157 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_refit.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/14 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/14 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include <string.h>
+
+/*
+** Refit after interactive edits. A moved object only flags its leaf,
+** found through the slot index (bvh_slots.c); bvh_refit then
+** recomputes the flagged leaves and their ancestors, bottom-up,
+** keeping the tree's topology. Children always come after their
+** parent in the depth-first node array, so a sweep from the last node
+** to the root sees every child before its parent.
+*/
+
+/* Flag the leaf holding ref; objects outside the BVH are ignored */
+void	bvh_mark_dirty(t_bvh *bvh, t_object_ref ref)
+{
+	int	slot;
+
+	if (!bvh || !bvh->nodes)
+		return ;
+	slot = bvh_object_slot(bvh, ref);
+	if (slot < 0)
+		return ;
+	if (!bvh->dirty[bvh->prim_leaf[slot]])
+		bvh->dirty_count++;
+	bvh->dirty[bvh->prim_leaf[slot]] = 1;
+}
+
+/* Node's term of the SAH cost: its area times the tests it costs */
+static t_real	node_cost(t_bvh_flat_node *node)
+{
+	if (node->count > 0)
+		return (aabb_surface_area(bvh_flat_bounds(node)) * node->count);
+	return (aabb_surface_area(bvh_flat_bounds(node)) * BVH_TRAVERSAL_COST);
+}
+
+/* Sum of every node's SAH term, before dividing by the root's area */
+double	bvh_sah_sum(const t_bvh *bvh)
+{
+	double	sum;
+	int		i;
+
+	sum = 0;
+	i = 0;
+	while (i < bvh->total_nodes)
+		sum += node_cost(&bvh->nodes[i++]);
+	return (sum);
+}
+
+/* A node-term sum as a SAH cost: sum over the root's surface area */
+t_real	bvh_sah_per_root(const t_bvh *bvh, double sum)
+{
+	t_real	root_area;
+
+	root_area = aabb_surface_area(bvh_flat_bounds(&bvh->nodes[0]));
+	if (root_area <= 0)
+		return (0);
+	return (sum / root_area);
+}
+
+/*
+** Expected cost of a random ray hitting the root, in object tests:
+** the same measure the SAH builder minimizes.
+*/
+t_real	bvh_sah_cost(t_bvh *bvh)
+{
+	if (!bvh || !bvh->nodes)
+		return (0);
+	return (bvh_sah_per_root(bvh, bvh_sah_sum(bvh)));
+}
+
+/*
+** Add (sign 1) or remove (sign -1) node's share of the running sums:
+** its SAH term and the overlap of its children.
+*/
+static void	node_terms(t_bvh *bvh, int index, int sign)
+{
+	bvh->sah_sum += sign * node_cost(&bvh->nodes[index]);
+	bvh->stats.overlap += sign * bvh_node_overlap(bvh, index);
+}
+
+/* Recompute a node's box from its objects or its two children */
+static void	refit_node(t_bvh *bvh, int index, void *scene)
+{
+	t_bvh_flat_node	*node;
+	t_aabb			box;
+
+	node = &bvh->nodes[index];
+	if (node->count > 0)
+		box = bvh_compute_bounds(bvh->prims + node->offset, node->count,
+				scene);
+	else
+		box = aabb_merge(bvh_flat_bounds(&bvh->nodes[index + 1]),
+				bvh_flat_bounds(&bvh->nodes[node->offset]));
+	bvh_flat_store_bounds(node, box);
+}
+
+/* Refit the flagged nodes bottom-up and add their new terms */
+static void	refit_flagged(t_bvh *bvh, void *scene)
+{
+	int	i;
+
+	i = bvh->total_nodes;
+	while (--i >= 0)
+	{
+		if (bvh->dirty[i])
+		{
+			refit_node(bvh, i, scene);
+			node_terms(bvh, i, 1);
+		}
+	}
+}
+
+/*
+** Refit every flagged leaf and its ancestors, then clear the flags
+** and collapse the wide tree again from the refitted boxes. The first
+** sweep flags the ancestors and takes the old boxes' terms out of the
+** running sums, the second refits and adds the new ones, so the SAH
+** cost is updated along the refitted nodes only.
+** Returns 1 when the refitted tree's SAH sum has grown past
+** BVH_REFIT_MAX_GROWTH times its build-time sum and it should be
+** rebuilt.
+*/
+int	bvh_refit(t_bvh *bvh, void *scene)
+{
+	t_bvh_flat_node	*node;
+	int				i;
+
+	if (!bvh || !bvh->nodes || bvh->dirty_count == 0)
+		return (0);
+	i = bvh->total_nodes;
+	while (--i >= 0)
+	{
+		node = &bvh->nodes[i];
+		if (node->count == 0 && (bvh->dirty[i + 1] || bvh->dirty[node->offset]))
+			bvh->dirty[i] = 1;
+		if (bvh->dirty[i])
+			node_terms(bvh, i, -1);
+	}
+	refit_flagged(bvh, scene);
+	memset(bvh->dirty, 0, bvh->total_nodes);
+	bvh->dirty_count = 0;
+	bvh_wide_build(bvh);
+	bvh_stats_update_costs(bvh);
+	return (bvh->sah_sum > bvh->build_sum * BVH_REFIT_MAX_GROWTH);
+}
@@ -0,0 +1,273 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_sah.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/11 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/11 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include "minirt.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** Binned surface area heuristic builder.
+** Object centroids are dropped into SAH_BINS bins per axis and every
+** bin boundary is scored as a split:
+**   cost = BVH_TRAVERSAL_COST + (A_left * N_left + A_right * N_right) / A
+** in units of one object test. A node becomes a leaf when no split
+** beats testing its objects directly (cost N) and it holds at most
+** SAH_MAX_LEAF objects. The bins of all three axes are filled in one
+** pass, so each object's bounds and centroid are looked up once per
+** node rather than once per axis (a triangle's means three vertex
+** loads scattered over the vertex buffer).
+*/
+
+#define SAH_BINS 16
+#define SAH_MAX_LEAF 4
+
+typedef struct s_sah_bin
+{
+	t_aabb	bounds;
+	int		count;
+}	t_sah_bin;
+
+/* Candidate split: objects whose centroid bin is below bin go left */
+typedef struct s_sah_split
+{
+	int		axis;
+	int		bin;
+	t_real	cost;
+	t_real	min;
+	t_real	scale;
+}	t_sah_split;
+
+/*
+** Objects of the node being split; area is the node's surface area
+** and bins[axis] the bins of each axis.
+*/
+typedef struct s_sah_ctx
+{
+	t_object_ref	*objects;
+	int				count;
+	void			*scene;
+	t_real			area;
+	t_sah_bin		bins[3][SAH_BINS];
+}	t_sah_ctx;
+
+static t_real	axis_value(t_vec3 v, int axis)
+{
+	if (axis == 0)
+		return (v.x);
+	if (axis == 1)
+		return (v.y);
+	return (v.z);
+}
+
+static int	bin_of(t_sah_split *split, t_vec3 center)
+{
+	int	bin;
+
+	bin = (int)((axis_value(center, split->axis) - split->min)
+			* split->scale);
+	if (bin < 0)
+		return (0);
+	if (bin >= SAH_BINS)
+		return (SAH_BINS - 1);
+	return (bin);
+}
+
+/* Add a bin's objects to a running box and count */
+static void	grow(t_aabb *box, int *count, t_sah_bin *bin)
+{
+	if (bin->count == 0)
+		return ;
+	if (*count == 0)
+		*box = bin->bounds;
+	else
+		*box = aabb_merge(*box, bin->bounds);
+	*count += bin->count;
+}
+
+/* Bin every object on each axis that can be split (scale > 0) */
+static void	fill_bins(t_sah_ctx *ctx, t_sah_split *cand)
+{
+	t_sah_bin	object;
+	t_sah_bin	*bin;
+	t_vec3		center;
+	int			axis;
+	int			i;
+
+	memset(ctx->bins, 0, sizeof(ctx->bins));
+	object.count = 1;
+	i = -1;
+	while (++i < ctx->count)
+	{
+		object.bounds = get_object_bounds(ctx->objects[i], ctx->scene);
+		center = get_object_center(ctx->objects[i], ctx->scene);
+		axis = -1;
+		while (++axis < 3)
+		{
+			if (cand[axis].scale > 0)
+			{
+				bin = &ctx->bins[axis][bin_of(&cand[axis], center)];
+				grow(&bin->bounds, &bin->count, &object);
+			}
+		}
+	}
+}
+
+/*
+** Score every bin boundary of cand's axis. right_cost[i] holds
+** A * N of bins i..SAH_BINS-1, built by a sweep from the right;
+** the left side is accumulated on the way back.
+*/
+static void	sweep_bins(t_sah_bin *bins, t_real area, t_sah_split *cand,
+		t_sah_split *best)
+{
+	t_real	right_cost[SAH_BINS];
+	int		right_count[SAH_BINS];
+	t_aabb	box;
+	int		count;
+	int		i;
+
+	box = bins[0].bounds;
+	count = 0;
+	i = SAH_BINS;
+	while (--i > 0)
+	{
+		grow(&box, &count, &bins[i]);
+		right_count[i] = count;
+		right_cost[i] = 0;
+		if (count > 0)
+			right_cost[i] = aabb_surface_area(box) * count;
+	}
+	count = 0;
+	while (++i < SAH_BINS)
+	{
+		grow(&box, &count, &bins[i - 1]);
+		if (count > 0 && right_count[i] > 0)
+		{
+			cand->bin = i;
+			cand->cost = BVH_TRAVERSAL_COST + (aabb_surface_area(box) * count
+					+ right_cost[i]) / area;
+			if (cand->cost < best->cost)
+				*best = *cand;
+		}
+	}
+}
+
+/* Box around the centroids of the node's objects */
+static t_aabb	centroid_bounds(t_sah_ctx *ctx)
+{
+	t_aabb	centroids;
+	t_vec3	center;
+	int		i;
+
+	centroids.min = get_object_center(ctx->objects[0], ctx->scene);
+	centroids.max = centroids.min;
+	i = 0;
+	while (++i < ctx->count)
+	{
+		center = get_object_center(ctx->objects[i], ctx->scene);
+		centroids = aabb_merge(centroids, aabb_create(center, center));
+	}
+	return (centroids);
+}
+
+/* Cheapest split over all three axes; bin is -1 if none exists */
+static t_sah_split	find_split(t_sah_ctx *ctx)
+{
+	t_sah_split	best;
+	t_sah_split	cand[3];
+	t_aabb		centroids;
+	int			axis;
+
+	centroids = centroid_bounds(ctx);
+	best = (t_sah_split){0, -1, REAL_MAX, 0, 0};
+	axis = -1;
+	while (++axis < 3)
+	{
+		cand[axis] = best;
+		cand[axis].axis = axis;
+		cand[axis].min = axis_value(centroids.min, axis);
+		if (axis_value(centroids.max, axis) > cand[axis].min)
+			cand[axis].scale = SAH_BINS
+				/ (axis_value(centroids.max, axis) - cand[axis].min);
+	}
+	fill_bins(ctx, cand);
+	axis = -1;
+	while (++axis < 3)
+	{
+		if (cand[axis].scale > 0)
+			sweep_bins(ctx->bins[axis], ctx->area, &cand[axis], &best);
+	}
+	return (best);
+}
+
+/* Move objects of bins below split->bin to the front; returns their count */
+static int	partition_bins(t_sah_ctx *ctx, t_sah_split *split)
+{
+	t_object_ref	temp;
+	int				left_count;
+	int				i;
+
+	left_count = 0;
+	i = 0;
+	while (i < ctx->count)
+	{
+		if (bin_of(split, get_object_center(ctx->objects[i], ctx->scene))
+			< split->bin)
+		{
+			temp = ctx->objects[left_count];
+			ctx->objects[left_count] = ctx->objects[i];
+			ctx->objects[i] = temp;
+			left_count++;
+		}
+		i++;
+	}
+	return (left_count);
+}
+
+/*
+** Build a subtree with the binned SAH. Objects whose centroids all
+** coincide cannot be binned; a large group of them is halved instead.
+*/
+t_bvh_node	*bvh_build_sah(t_bvh_task *task)
+{
+	t_bvh_node	*node;
+	t_sah_ctx	ctx;
+	t_sah_split	split;
+	int			mid;
+
+	if (task->count <= 1 || task->depth > BVH_MAX_DEPTH)
+		return (bvh_create_leaf(task->objects, task->count, task->scene));
+	ctx.objects = task->objects;
+	ctx.count = task->count;
+	ctx.scene = task->scene;
+	node = malloc(sizeof(t_bvh_node));
+	if (!node)
+		return (NULL);
+	node->bounds = bvh_compute_bounds(ctx.objects, ctx.count, ctx.scene);
+	ctx.area = aabb_surface_area(node->bounds);
+	split = find_split(&ctx);
+	if ((split.bin < 0 || split.cost >= ctx.count)
+		&& ctx.count <= SAH_MAX_LEAF)
+	{
+		free(node);
+		return (bvh_create_leaf(ctx.objects, ctx.count, ctx.scene));
+	}
+	mid = ctx.count / 2;
+	if (split.bin >= 0)
+		mid = partition_bins(&ctx, &split);
+	node->axis = split.axis;
+	node->objects = NULL;
+	node->object_count = 0;
+	bvh_build_children(node, task, mid);
+	return (node);
+}
@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_slots.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:05:31 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 18:05:31 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include "window.h"
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(OBJ_TRIANGLE < BVH_REF_TYPES, "slot index misses a type");
+
+/*
+** Object -> prims slot index, so bvh_mark_dirty finds a moved
+** object's leaf without scanning prims. Object (type, index) sits at
+** slot[slot_base[type] + index]: each type gets one entry per index up
+** to the largest one in the tree, -1 where an object is not in it.
+*/
+
+/* Lay out slot_base from the largest index of each type in prims */
+static void	slot_bases(t_bvh *bvh)
+{
+	t_object_ref	ref;
+	int				i;
+
+	memset(bvh->slot_base, 0, sizeof(bvh->slot_base));
+	i = 0;
+	while (i < bvh->prim_count)
+	{
+		ref = bvh->prims[i++];
+		if (ref.type >= 0 && ref.type < BVH_REF_TYPES
+			&& ref.index >= bvh->slot_base[ref.type + 1])
+			bvh->slot_base[ref.type + 1] = ref.index + 1;
+	}
+	i = 0;
+	while (++i <= BVH_REF_TYPES)
+		bvh->slot_base[i] += bvh->slot_base[i - 1];
+}
+
+/*
+** (Re)build the index over the current prims; called once they are
+** final (flatten, cache load). Returns 0 if it cannot be allocated.
+*/
+int	bvh_index_slots(t_bvh *bvh)
+{
+	t_object_ref	ref;
+	int				i;
+
+	slot_bases(bvh);
+	free(bvh->slot);
+	bvh->slot = malloc(sizeof(int) * (bvh->slot_base[BVH_REF_TYPES] + 1));
+	if (!bvh->slot)
+		return (0);
+	memset(bvh->slot, 0xff, sizeof(int) * bvh->slot_base[BVH_REF_TYPES]);
+	i = 0;
+	while (i < bvh->prim_count)
+	{
+		ref = bvh->prims[i];
+		if (ref.type >= 0 && ref.type < BVH_REF_TYPES && ref.index >= 0)
+			bvh->slot[bvh->slot_base[ref.type] + ref.index] = i;
+		i++;
+	}
+	return (1);
+}
+
+/* Slot of ref in prims, or -1 if the object is not in the tree */
+int	bvh_object_slot(const t_bvh *bvh, t_object_ref ref)
+{
+	if (!bvh->slot || ref.type < 0 || ref.type >= BVH_REF_TYPES
+		|| ref.index < 0
+		|| ref.index >= bvh->slot_base[ref.type + 1]
+		- bvh->slot_base[ref.type])
+		return (-1);
+	return (bvh->slot[bvh->slot_base[ref.type] + ref.index]);
+}
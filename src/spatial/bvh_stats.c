@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_stats.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/19 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/19 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static double	volume(t_aabb box)
+{
+	if (box.max.x <= box.min.x || box.max.y <= box.min.y
+		|| box.max.z <= box.min.z)
+		return (0);
+	return ((double)(box.max.x - box.min.x) * (box.max.y - box.min.y)
+		* (box.max.z - box.min.z));
+}
+
+/* Volume of the intersection of two boxes (0 if they are disjoint) */
+static double	overlap_volume(t_aabb a, t_aabb b)
+{
+	t_aabb	both;
+
+	both.min.x = fmax(a.min.x, b.min.x);
+	both.min.y = fmax(a.min.y, b.min.y);
+	both.min.z = fmax(a.min.z, b.min.z);
+	both.max.x = fmin(a.max.x, b.max.x);
+	both.max.y = fmin(a.max.y, b.max.y);
+	both.max.z = fmin(a.max.z, b.max.z);
+	return (volume(both));
+}
+
+static void	count_leaf(t_bvh_stats *stats, int count, int depth)
+{
+	stats->leaves++;
+	stats->avg_depth += depth;
+	if (stats->leaves == 1 || depth < stats->min_depth)
+		stats->min_depth = depth;
+	if (depth > stats->max_depth)
+		stats->max_depth = depth;
+	if (depth >= BVH_STATS_DEPTHS)
+		depth = BVH_STATS_DEPTHS - 1;
+	stats->depth_hist[depth]++;
+	if (count > BVH_STATS_LEAF_BINS)
+		count = BVH_STATS_LEAF_BINS;
+	stats->leaf_hist[count - 1]++;
+}
+
+/* Volume an inner node's two children share; 0 for a leaf */
+double	bvh_node_overlap(const t_bvh *bvh, int index)
+{
+	const t_bvh_flat_node	*node;
+
+	node = &bvh->nodes[index];
+	if (node->count > 0)
+		return (0);
+	return (overlap_volume(bvh_flat_bounds(&bvh->nodes[index + 1]),
+			bvh_flat_bounds(&bvh->nodes[node->offset])));
+}
+
+static void	stats_node(t_bvh *bvh, int index, int depth)
+{
+	t_bvh_flat_node	*node;
+
+	node = &bvh->nodes[index];
+	bvh->stats.nodes++;
+	if (node->count > 0)
+	{
+		count_leaf(&bvh->stats, node->count, depth);
+		return ;
+	}
+	bvh->stats.overlap += bvh_node_overlap(bvh, index);
+	stats_node(bvh, index + 1, depth + 1);
+	stats_node(bvh, node->offset, depth + 1);
+}
+
+/*
+** SAH cost and overlap ratio from the running sums (sah_sum and
+** stats.overlap). A refit keeps the topology, so these are the only
+** figures it changes; bvh_refit updates the sums along the refitted
+** nodes and calls this instead of a full bvh_compute_stats.
+*/
+void	bvh_stats_update_costs(t_bvh *bvh)
+{
+	double	root_volume;
+
+	bvh->stats.sah_cost = bvh_sah_per_root(bvh, bvh->sah_sum);
+	bvh->stats.overlap_ratio = 0;
+	root_volume = volume(bvh_flat_bounds(&bvh->nodes[0]));
+	if (root_volume > 0)
+		bvh->stats.overlap_ratio = bvh->stats.overlap / root_volume;
+}
+
+/*
+** Walk the flat tree once and refresh bvh->stats: node and leaf
+** counts, leaf depth and occupancy histograms, SAH cost and the
+** volume siblings share. Called after every build and load; it also
+** seeds sah_sum and build_sum for later refits.
+*/
+void	bvh_compute_stats(t_bvh *bvh)
+{
+	t_bvh_stats	*stats;
+
+	stats = &bvh->stats;
+	memset(stats, 0, sizeof(t_bvh_stats));
+	if (!bvh->nodes)
+		return ;
+	stats_node(bvh, 0, 0);
+	if (stats->leaves > 0)
+		stats->avg_depth /= stats->leaves;
+	bvh->sah_sum = bvh_sah_sum(bvh);
+	bvh->build_sum = bvh->sah_sum;
+	bvh_stats_update_costs(bvh);
+}
+
+/* Print the non-empty bins of a histogram as " key:count" pairs */
+static void	print_hist(const char *label, const int *hist, int bins,
+		int first)
+{
+	int	i;
+
+	printf("  %-10s", label);
+	i = 0;
+	while (i < bins)
+	{
+		if (hist[i] > 0 && i == bins - 1)
+			printf(" %d+:%d", i + first, hist[i]);
+		else if (hist[i] > 0)
+			printf(" %d:%d", i + first, hist[i]);
+		i++;
+	}
+	printf("\n");
+}
+
+/* Multi-line dump of bvh->stats for --bvh-stats */
+void	bvh_print_stats(const t_bvh *bvh)
+{
+	const t_bvh_stats	*stats;
+
+	stats = &bvh->stats;
+	printf("BVH stats:\n");
+	printf("  nodes      %d (%d inner, %d leaves)\n", stats->nodes,
+		stats->nodes - stats->leaves, stats->leaves);
+	printf("  leaf depth min %d, avg %.2f, max %d\n", stats->min_depth,
+		stats->avg_depth, stats->max_depth);
+	printf("  SAH cost   %.3f\n", stats->sah_cost);
+	printf("  overlap    %.4g (%.2f%% of root volume)\n", stats->overlap,
+		stats->overlap_ratio * 100);
+	print_hist("depth", stats->depth_hist, BVH_STATS_DEPTHS, 0);
+	print_hist("leaf size", stats->leaf_hist, BVH_STATS_LEAF_BINS, 1);
+}
+
+/*
+** Bytes the tree holds: flat nodes and their dirty flags, the object
+** references with their leaf and slot indices, and the wide tree if
+** one was built.
+*/
+size_t	bvh_memory_bytes(const t_bvh *bvh)
+{
+	return ((size_t)bvh->total_nodes * (sizeof(t_bvh_flat_node) + 1)
+		+ (size_t)bvh->prim_count * (sizeof(t_object_ref) + sizeof(int))
+		+ (size_t)bvh->slot_base[BVH_REF_TYPES] * sizeof(int)
+		+ bvh->wide_bytes);
+}
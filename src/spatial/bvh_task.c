@@ -0,0 +1,95 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_task.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/17 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/17 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include <pthread.h>
+#include <unistd.h>
+
+/*
+** Task-parallel BVH build. The two halves of a split share no objects
+** and the builders only read the scene, so a subtree can be built on
+** another thread without locking. Forking stops after task->forks
+** levels or once a subtree is too small to pay for a thread; the tree
+** is the same whatever the thread count.
+*/
+
+typedef struct s_bvh_fork
+{
+	t_bvh_task	task;
+	t_bvh_node	*node;
+	pthread_t	thread;
+}	t_bvh_fork;
+
+/* Number of build threads for --bvh-threads (0 = one per CPU) */
+int	bvh_build_threads(int threads)
+{
+	long	cpus;
+
+	if (threads > 0)
+		return (threads);
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 1)
+		return (1);
+	return ((int)cpus);
+}
+
+t_bvh_node	*bvh_build_subtree(t_bvh_task *task)
+{
+	if (task->builder == BVH_BUILDER_MIDPOINT)
+		return (bvh_build_recursive(task));
+	return (bvh_build_sah(task));
+}
+
+static void	*fork_main(void *arg)
+{
+	t_bvh_fork	*fork;
+
+	fork = arg;
+	fork->node = bvh_build_subtree(&fork->task);
+	return (NULL);
+}
+
+static t_bvh_task	child_task(t_bvh_task *parent, int offset, int count)
+{
+	t_bvh_task	child;
+
+	child = *parent;
+	child.objects += offset;
+	child.count = count;
+	child.depth++;
+	if (child.forks > 0)
+		child.forks--;
+	return (child);
+}
+
+/*
+** Build node's children from task->objects split at mid. The left
+** half goes to a new thread when forking is still allowed (and runs
+** here if the thread cannot start) while this thread builds the right.
+*/
+void	bvh_build_children(t_bvh_node *node, t_bvh_task *task, int mid)
+{
+	t_bvh_fork	left;
+	t_bvh_task	right;
+	int			forked;
+
+	left.task = child_task(task, 0, mid);
+	right = child_task(task, mid, task->count - mid);
+	forked = task->forks > 0 && task->count >= BVH_FORK_MIN_OBJECTS
+		&& pthread_create(&left.thread, NULL, fork_main, &left) == 0;
+	if (!forked)
+		left.node = bvh_build_subtree(&left.task);
+	node->right = bvh_build_subtree(&right);
+	if (forked)
+		pthread_join(left.thread, NULL);
+	node->left = left.node;
+}
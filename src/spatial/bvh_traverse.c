@@ -15,89 +15,211 @@
 #include "window.h"
 #include "ray.h"
 
-static int	intersect_object(t_object_ref ref, t_ray ray, t_hit_record *hit,
+_Static_assert(BVH_STACK_SIZE >= BVH_MAX_DEPTH + 2, "walk stack too small");
+
+/* One closest-hit query: the BVH, the ray and the scene it indexes */
+typedef struct s_bvh_query
+{
+	t_bvh	*bvh;
+	t_ray	ray;
+	void	*scene;
+}	t_bvh_query;
+
+/* Test one object; hit->distance is the closest hit so far */
+int	bvh_intersect_object(t_object_ref ref, t_ray *ray, t_hit_record *hit,
 		void *scene_ptr)
 {
 	t_scene	*scene;
 
 	scene = (t_scene *)scene_ptr;
 	if (ref.type == OBJ_SPHERE)
-		return (intersect_sphere(&ray, &scene->spheres[ref.index], hit));
+		return (intersect_sphere(ray, &scene->spheres[ref.index], hit));
 	else if (ref.type == OBJ_PLANE)
-		return (intersect_plane(&ray, &scene->planes[ref.index], hit));
+		return (intersect_plane(ray, &scene->planes[ref.index], hit));
 	else if (ref.type == OBJ_CYLINDER)
-		return (intersect_cylinder(&ray, &scene->cylinders[ref.index], hit));
+		return (intersect_cylinder(ray, &scene->cylinders[ref.index], hit));
+	else if (ref.type == OBJ_INSTANCE)
+		return (instance_intersect(scene, &scene->instances[ref.index], ray,
+				hit));
+	else if (ref.type == OBJ_TRIANGLE)
+		return (intersect_triangle(ray, scene, ref.index, hit));
 	return (0);
 }
 
-static int	bvh_leaf_intersect(t_bvh_node *node, t_ray ray, t_hit_record *hit,
-		void *scene)
+/*
+** Closest hit among a leaf's objects. temp_hit.distance carries the
+** best distance so far; intersect_* only accept strictly closer hits.
+*/
+static int	bvh_leaf_intersect(t_bvh_query *query, t_bvh_flat_node *node,
+		t_hit_record *hit)
 {
+	t_object_ref	*prims;
 	int				i;
 	int				hit_anything;
 	t_hit_record	temp_hit;
 
+	prims = query->bvh->prims + node->offset;
 	hit_anything = 0;
+	temp_hit.distance = REAL_MAX;
 	i = 0;
-	while (i < node->object_count)
+	while (i < (int)node->count)
 	{
-		if (intersect_object(node->objects[i], ray, &temp_hit, scene))
+		if (bvh_intersect_object(prims[i], &query->ray, &temp_hit, query->scene))
 		{
-			if (!hit_anything || temp_hit.distance < hit->distance)
-			{
-				*hit = temp_hit;
-				hit_anything = 1;
-			}
+			*hit = temp_hit;
+			hit_anything = 1;
 		}
 		i++;
 	}
 	return (hit_anything);
 }
 
-int	bvh_node_intersect(t_bvh_node *node, t_ray ray, t_hit_record *hit,
-		void *scene)
+/* Box test of node, clipped to the closest hit found so far */
+static int	bvh_box_hit(t_bvh_query *query, t_bvh_flat_node *node,
+		t_real closest)
+{
+	t_aabb	box;
+	t_real	t_range[2];
+
+	box = bvh_flat_bounds(node);
+	t_range[0] = RAY_T_MIN;
+	t_range[1] = 1000000.0;
+	if (closest < t_range[1])
+		t_range[1] = closest;
+	return (aabb_intersect(&box, &query->ray, &t_range[0], &t_range[1]));
+}
+
+/*
+** Closest hit in the subtree at node_index, visiting both children of
+** every node hit (--bvh-traversal recursive, kept for A/B runs).
+** The left child directly follows its parent in the node array.
+*/
+static int	bvh_node_intersect(t_bvh_query *query, int node_index,
+		t_hit_record *hit)
 {
-	double			t_min;
-	double			t_max;
+	t_bvh_flat_node	*node;
 	int				hit_left;
 	int				hit_right;
-	t_hit_record	left_hit;
-	t_hit_record	right_hit;
+	t_hit_record	child_hit[2];
 
-	if (!node)
-		return (0);
-	t_min = 0.001;
-	t_max = 1000000.0;
-	if (!aabb_intersect(node->bounds, ray, &t_min, &t_max))
+	node = &query->bvh->nodes[node_index];
+	if (!bvh_box_hit(query, node, REAL_MAX))
 		return (0);
-	if (node->object_count > 0)
-		return (bvh_leaf_intersect(node, ray, hit, scene));
-	hit_left = bvh_node_intersect(node->left, ray, &left_hit, scene);
-	hit_right = bvh_node_intersect(node->right, ray, &right_hit, scene);
+	if (node->count > 0)
+		return (bvh_leaf_intersect(query, node, hit));
+	hit_left = bvh_node_intersect(query, node_index + 1, &child_hit[0]);
+	hit_right = bvh_node_intersect(query, node->offset, &child_hit[1]);
 	if (hit_left && hit_right)
 	{
-		if (left_hit.distance < right_hit.distance)
-			*hit = left_hit;
+		if (child_hit[0].distance < child_hit[1].distance)
+			*hit = child_hit[0];
 		else
-			*hit = right_hit;
+			*hit = child_hit[1];
 		return (1);
 	}
 	if (hit_left)
 	{
-		*hit = left_hit;
+		*hit = child_hit[0];
 		return (1);
 	}
 	if (hit_right)
 	{
-		*hit = right_hit;
+		*hit = child_hit[1];
 		return (1);
 	}
 	return (0);
 }
 
+/*
+** Push the children of inner node index, nearer child last so it is
+** popped first. Both builders put the lower half of the split axis on
+** the left, so a ray heading toward -axis reaches the right one first.
+*/
+static int	bvh_push_children(t_bvh_query *query, int index, int *stack,
+		int top)
+{
+	t_bvh_flat_node	*node;
+
+	node = &query->bvh->nodes[index];
+	if (query->ray.sign[node->axis])
+	{
+		stack[top++] = index + 1;
+		stack[top++] = node->offset;
+		return (top);
+	}
+	stack[top++] = node->offset;
+	stack[top++] = index + 1;
+	return (top);
+}
+
+/* Leaf of the ordered walk: objects test straight into hit */
+static int	bvh_leaf_closest(t_bvh_query *query, t_bvh_flat_node *node,
+		t_hit_record *hit)
+{
+	t_object_ref	*prims;
+	int				i;
+	int				hit_anything;
+
+	prims = query->bvh->prims + node->offset;
+	hit_anything = 0;
+	i = 0;
+	while (i < (int)node->count)
+	{
+		if (bvh_intersect_object(prims[i], &query->ray, hit, query->scene))
+			hit_anything = 1;
+		i++;
+	}
+	return (hit_anything);
+}
+
+/*
+** Front-to-back closest hit. hit->distance is always the closest hit
+** so far and prunes every box entered beyond it.
+*/
+static int	bvh_ordered_intersect(t_bvh_query *query, t_hit_record *hit)
+{
+	int				stack[BVH_STACK_SIZE];
+	t_bvh_flat_node	*node;
+	int				top;
+	int				index;
+	int				hit_anything;
+
+	hit_anything = 0;
+	stack[0] = 0;
+	top = 1;
+	while (top > 0)
+	{
+		index = stack[--top];
+		node = &query->bvh->nodes[index];
+		if (bvh_box_hit(query, node, hit->distance))
+		{
+			if (node->count > 0)
+				hit_anything |= bvh_leaf_closest(query, node, hit);
+			else
+				top = bvh_push_children(query, index, stack, top);
+		}
+	}
+	return (hit_anything);
+}
+
+/*
+** Closest hit among the BVH's objects; ray must have been through
+** ray_prepare.
+*/
 int	bvh_intersect(t_bvh *bvh, t_ray ray, t_hit_record *hit, void *scene)
 {
-	if (!bvh || !bvh->root || !bvh->enabled)
+	t_bvh_query	query;
+
+	if (!bvh || !bvh->nodes || !bvh->enabled)
 		return (0);
-	return (bvh_node_intersect(bvh->root, ray, hit, scene));
+	query.bvh = bvh;
+	query.ray = ray;
+	query.scene = scene;
+	if (bvh->config.traversal == BVH_TRAVERSAL_RECURSIVE)
+		return (bvh_node_intersect(&query, 0, hit));
+	if (bvh->wide && bvh->config.width == 8)
+		return (bvh_wide8_intersect(bvh, ray, hit, scene));
+	if (bvh->wide && bvh->config.width == 4)
+		return (bvh_wide4_intersect(bvh, ray, hit, scene));
+	return (bvh_ordered_intersect(&query, hit));
 }
@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_wide.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/15 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/15 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "spatial.h"
+#include "packet.h"
+#include <stdlib.h>
+
+/*
+** The wide kernels are built with -mavx2 on x86 (see the Makefile),
+** so they only run on CPUs that have it; other targets build them
+** for their baseline SIMD.
+*/
+static int	wide_supported(void)
+{
+#if defined(__x86_64__)
+	return (cpu_has_avx2());
+#else
+	return (1);
+#endif
+}
+
+void	bvh_wide_clear(t_bvh *bvh)
+{
+	free(bvh->wide);
+	bvh->wide = NULL;
+	bvh->wide_count = 0;
+	bvh->wide_bytes = 0;
+}
+
+/*
+** (Re)collapse the binary nodes into the wide tree selected by
+** config.width. Width 2, or a CPU the wide kernels cannot run on,
+** keeps only the binary tree. Returns 0 if the wide tree could not
+** be allocated; bvh_intersect then falls back to the binary walk.
+*/
+int	bvh_wide_build(t_bvh *bvh)
+{
+	bvh_wide_clear(bvh);
+	if (!bvh->nodes || !wide_supported())
+		return (1);
+	if (bvh->config.width == 4)
+		return (bvh_wide4_build(bvh));
+	if (bvh->config.width == 8)
+		return (bvh_wide8_build(bvh));
+	return (1);
+}
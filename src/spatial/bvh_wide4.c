@@ -0,0 +1,22 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_wide4.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/15 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/15 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** 4-wide BVH (4 children tested per node).
+*/
+
+#define BVH_WIDTH 4
+#define BVH_WIDE_BUILD bvh_wide4_build
+#define BVH_WIDE_INTERSECT bvh_wide4_intersect
+#define BVH_WIDE_OCCLUDED bvh_wide4_occluded
+
+#include "bvh_wide.h"
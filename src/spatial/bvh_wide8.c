@@ -0,0 +1,22 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bvh_wide8.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/15 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/15 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** 8-wide BVH (8 children tested per node).
+*/
+
+#define BVH_WIDTH 8
+#define BVH_WIDE_BUILD bvh_wide8_build
+#define BVH_WIDE_INTERSECT bvh_wide8_intersect
+#define BVH_WIDE_OCCLUDED bvh_wide8_occluded
+
+#include "bvh_wide.h"
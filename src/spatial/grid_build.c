@@ -0,0 +1,213 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grid_build.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:03:38 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 14:03:38 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "accel.h"
+#include <math.h>
+#include <stdlib.h>
+
+static t_real	axis_value(t_vec3 v, int axis)
+{
+	if (axis == 0)
+		return (v.x);
+	if (axis == 1)
+		return (v.y);
+	return (v.z);
+}
+
+/*
+** Bounds of every object, computed once for both fill passes, and
+** their union, padded so no object touches the grid's outer faces.
+*/
+static t_aabb	*object_boxes(t_grid *grid, t_object_ref *refs, int count,
+		t_scene *scene)
+{
+	t_aabb	*boxes;
+	t_vec3	pad;
+	int		i;
+
+	boxes = malloc(sizeof(t_aabb) * count);
+	if (!boxes)
+		return (NULL);
+	i = 0;
+	while (i < count)
+	{
+		boxes[i] = get_object_bounds(refs[i], scene);
+		if (i == 0)
+			grid->bounds = boxes[0];
+		grid->bounds = aabb_merge(grid->bounds, boxes[i]);
+		i++;
+	}
+	pad = (t_vec3){RAY_T_MIN, RAY_T_MIN, RAY_T_MIN};
+	grid->bounds.min = vec3_subtract(grid->bounds.min, pad);
+	grid->bounds.max = vec3_add(grid->bounds.max, pad);
+	return (boxes);
+}
+
+/*
+** About GRID_DENSITY cells per object, as close to cubic as the
+** bounds allow (Cleary and Wyvill): cells along an axis are its
+** length times the cube root of cells per unit volume.
+*/
+static void	grid_resolution(t_grid *grid, int count)
+{
+	t_real	size[3];
+	double	per_unit;
+	int		a;
+
+	a = -1;
+	while (++a < 3)
+		size[a] = axis_value(grid->bounds.max, a)
+			- axis_value(grid->bounds.min, a);
+	per_unit = cbrt(GRID_DENSITY * count / ((double)size[0] * size[1]
+				* size[2]));
+	a = -1;
+	while (++a < 3)
+	{
+		grid->res[a] = (int)(size[a] * per_unit);
+		if (grid->res[a] < 1)
+			grid->res[a] = 1;
+		if (grid->res[a] > GRID_MAX_RES)
+			grid->res[a] = GRID_MAX_RES;
+		grid->min[a] = axis_value(grid->bounds.min, a);
+		grid->cell[a] = size[a] / grid->res[a];
+		grid->inv_cell[a] = grid->res[a] / size[a];
+	}
+}
+
+/* Cell of coordinate value along axis, clamped to the grid */
+static int	cell_of(t_grid *grid, int axis, t_real value)
+{
+	int	cell;
+
+	cell = (int)((value - grid->min[axis]) * grid->inv_cell[axis]);
+	if (cell < 0)
+		return (0);
+	if (cell >= grid->res[axis])
+		return (grid->res[axis] - 1);
+	return (cell);
+}
+
+/* Cells box overlaps: lo[axis] .. hi[axis] inclusive */
+static void	cell_range(t_grid *grid, t_aabb *box, int *lo, int *hi)
+{
+	int	axis;
+
+	axis = 0;
+	while (axis < 3)
+	{
+		lo[axis] = cell_of(grid, axis, axis_value(box->min, axis));
+		hi[axis] = cell_of(grid, axis, axis_value(box->max, axis));
+		axis++;
+	}
+}
+
+/*
+** Visit every cell box overlaps: without ref, count the object in
+** cells[]; with ref, store it in front of the cell's current start
+** (the fill pass runs backwards, so cells keep the scene's order).
+*/
+static void	grid_insert(t_grid *grid, t_aabb *box, t_object_ref *ref)
+{
+	int	lo[3];
+	int	hi[3];
+	int	cell[3];
+	int	index;
+
+	cell_range(grid, box, lo, hi);
+	cell[2] = lo[2] - 1;
+	while (++cell[2] <= hi[2])
+	{
+		cell[1] = lo[1] - 1;
+		while (++cell[1] <= hi[1])
+		{
+			cell[0] = lo[0] - 1;
+			while (++cell[0] <= hi[0])
+			{
+				index = (cell[2] * grid->res[1] + cell[1]) * grid->res[0]
+					+ cell[0];
+				if (ref)
+					grid->refs[--grid->cells[index]] = *ref;
+				else
+					grid->cells[index]++;
+			}
+		}
+	}
+}
+
+/*
+** Counting sort of (cell, object) pairs in O(objects + references):
+** count per cell, turn counts into running ends, then drop each
+** reference in front of its cell's end, which leaves cells[i] at
+** the start of cell i and cells[n] at the total.
+*/
+static int	grid_fill(t_grid *grid, t_object_ref *refs, t_aabb *boxes,
+		int count)
+{
+	int	cells;
+	int	i;
+
+	cells = grid->res[0] * grid->res[1] * grid->res[2];
+	i = -1;
+	while (++i < count)
+		grid_insert(grid, &boxes[i], NULL);
+	i = 0;
+	while (++i < cells)
+		grid->cells[i] += grid->cells[i - 1];
+	grid->ref_count = grid->cells[cells - 1];
+	grid->cells[cells] = grid->ref_count;
+	grid->refs = malloc(sizeof(t_object_ref) * grid->ref_count);
+	if (!grid->refs)
+		return (0);
+	i = count;
+	while (--i >= 0)
+		grid_insert(grid, &boxes[i], &refs[i]);
+	return (1);
+}
+
+/*
+** Uniform grid over count objects, built in linear time.
+** Returns NULL on allocation failure.
+*/
+t_grid	*grid_build(t_object_ref *refs, int count, t_scene *scene)
+{
+	t_grid	*grid;
+	t_aabb	*boxes;
+
+	grid = calloc(1, sizeof(t_grid));
+	if (!grid)
+		return (NULL);
+	boxes = object_boxes(grid, refs, count, scene);
+	if (boxes)
+		grid_resolution(grid, count);
+	if (boxes)
+		grid->cells = calloc((size_t)grid->res[0] * grid->res[1]
+				* grid->res[2] + 1, sizeof(int));
+	if (!boxes || !grid->cells || !grid_fill(grid, refs, boxes, count))
+	{
+		free(boxes);
+		grid_destroy(grid);
+		return (NULL);
+	}
+	free(boxes);
+	grid->object_count = count;
+	return (grid);
+}
+
+void	grid_destroy(t_grid *grid)
+{
+	if (!grid)
+		return ;
+	free(grid->cells);
+	free(grid->refs);
+	free(grid);
+}
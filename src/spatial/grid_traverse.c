@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grid_traverse.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:21:05 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 14:21:05 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "accel.h"
+
+/*
+** 3D-DDA state (Amanatides and Woo): the current cell, the step taken
+** along each axis, the distance at which the ray crosses into the
+** next cell along it, and the distance one whole cell spans.
+*/
+typedef struct s_grid_walk
+{
+	t_grid	*grid;
+	t_scene	*scene;
+	t_ray	*ray;
+	int		cell[3];
+	int		step[3];
+	t_real	next[3];
+	t_real	delta[3];
+}	t_grid_walk;
+
+static t_real	axis_value(t_vec3 v, int axis)
+{
+	if (axis == 0)
+		return (v.x);
+	if (axis == 1)
+		return (v.y);
+	return (v.z);
+}
+
+/*
+** Set up axis for a ray entering the grid at distance entry. An axis
+** the ray runs parallel to is never crossed.
+*/
+static void	walk_axis(t_grid_walk *w, int axis, t_real entry)
+{
+	t_real	origin;
+	t_real	inv_dir;
+	t_real	boundary;
+	int		cell;
+
+	origin = axis_value(w->ray->origin, axis);
+	inv_dir = axis_value(w->ray->inv_dir, axis);
+	cell = (int)((origin + entry * axis_value(w->ray->direction, axis)
+				- w->grid->min[axis]) * w->grid->inv_cell[axis]);
+	if (cell < 0)
+		cell = 0;
+	if (cell >= w->grid->res[axis])
+		cell = w->grid->res[axis] - 1;
+	w->cell[axis] = cell;
+	w->step[axis] = 1 - 2 * w->ray->sign[axis];
+	w->next[axis] = REAL_MAX;
+	w->delta[axis] = REAL_MAX;
+	if (axis_value(w->ray->direction, axis) == 0)
+		return ;
+	boundary = w->grid->min[axis] + (cell + 1 - w->ray->sign[axis])
+		* w->grid->cell[axis];
+	w->next[axis] = (boundary - origin) * inv_dir;
+	w->delta[axis] = w->grid->cell[axis] * REAL_FABS(inv_dir);
+}
+
+/* Objects of the current cell; with any, stop at the first occluder */
+static int	cell_hit(t_grid_walk *w, t_hit *hit, int any)
+{
+	t_grid	*grid;
+	int		i;
+	int		end;
+	int		found;
+
+	grid = w->grid;
+	i = (w->cell[2] * grid->res[1] + w->cell[1]) * grid->res[0]
+		+ w->cell[0];
+	end = grid->cells[i + 1];
+	i = grid->cells[i];
+	found = 0;
+	while (i < end)
+	{
+		if (any && bvh_occlude_object(grid->refs[i], w->ray, hit->distance,
+				w->scene))
+			return (1);
+		if (!any && bvh_intersect_object(grid->refs[i], w->ray, hit,
+				w->scene))
+			found = 1;
+		i++;
+	}
+	return (found);
+}
+
+/*
+** Step through the cells the ray crosses, nearest first. A hit is
+** final once it lies before the exit of the current cell; objects
+** spanning several cells may be tested again, which only costs time.
+*/
+static int	grid_walk(t_grid_walk *w, t_hit *hit, int any)
+{
+	int	found;
+	int	axis;
+
+	found = 0;
+	while (1)
+	{
+		found |= cell_hit(w, hit, any);
+		if (found && any)
+			return (1);
+		axis = 0;
+		if (w->next[1] < w->next[axis])
+			axis = 1;
+		if (w->next[2] < w->next[axis])
+			axis = 2;
+		if (w->next[axis] >= hit->distance)
+			return (found);
+		w->cell[axis] += w->step[axis];
+		if (w->cell[axis] < 0 || w->cell[axis] >= w->grid->res[axis])
+			return (found);
+		w->next[axis] += w->delta[axis];
+	}
+}
+
+/* Clip the ray to the grid below limit and find its first cell */
+static int	walk_start(t_grid_walk *w, t_real limit)
+{
+	t_real	t_min;
+	t_real	t_max;
+
+	t_min = 0;
+	t_max = limit;
+	if (!aabb_intersect(&w->grid->bounds, w->ray, &t_min, &t_max))
+		return (0);
+	walk_axis(w, 0, t_min);
+	walk_axis(w, 1, t_min);
+	walk_axis(w, 2, t_min);
+	return (1);
+}
+
+/* Closest hit below hit->distance; ray must be prepared */
+int	grid_intersect(t_grid *grid, t_scene *scene, t_ray *ray, t_hit *hit)
+{
+	t_grid_walk	w;
+
+	if (!grid)
+		return (0);
+	w.grid = grid;
+	w.scene = scene;
+	w.ray = ray;
+	if (!walk_start(&w, hit->distance))
+		return (0);
+	return (grid_walk(&w, hit, 0));
+}
+
+/* 1 if any object lies closer than max_distance; ray must be prepared */
+int	grid_occluded(t_grid *grid, t_scene *scene, t_ray *ray,
+		t_real max_distance)
+{
+	t_grid_walk	w;
+	t_hit		hit;
+
+	if (!grid)
+		return (0);
+	w.grid = grid;
+	w.scene = scene;
+	w.ray = ray;
+	hit.distance = max_distance;
+	if (!walk_start(&w, max_distance))
+		return (0);
+	return (grid_walk(&w, &hit, 1));
+}
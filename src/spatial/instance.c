@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   instance.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:40:12 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 10:40:12 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "spatial.h"
+
+/* Direction v in group space: the transpose of the instance basis */
+static t_vec3	to_group(const t_instance *instance, t_vec3 v)
+{
+	return ((t_vec3){vec3_dot(instance->axis[0], v),
+		vec3_dot(instance->axis[1], v), vec3_dot(instance->axis[2], v)});
+}
+
+/* Direction v of group space in world space */
+static t_vec3	to_world(const t_instance *instance, t_vec3 v)
+{
+	return (vec3_add(vec3_add(vec3_multiply(instance->axis[0], v.x),
+				vec3_multiply(instance->axis[1], v.y)),
+			vec3_multiply(instance->axis[2], v.z)));
+}
+
+/* Corner i of box: bit 0 picks max x, bit 1 max y, bit 2 max z */
+static t_vec3	box_corner(t_aabb box, int i)
+{
+	t_vec3	corner;
+
+	corner = box.min;
+	if (i & 1)
+		corner.x = box.max.x;
+	if (i & 2)
+		corner.y = box.max.y;
+	if (i & 4)
+		corner.z = box.max.z;
+	return (corner);
+}
+
+/*
+** World box of an instance: the eight corners of its group's BVH
+** root, placed by the instance transform. An instance whose group has
+** no tree (allocation failure) is a point that nothing can hit.
+*/
+static t_aabb	placed_bounds(t_scene *scene, const t_instance *instance)
+{
+	t_bvh	*blas;
+	t_aabb	root;
+	t_aabb	box;
+	t_vec3	corner;
+	int		i;
+
+	blas = scene->groups[instance->group].objects->render_state.bvh;
+	if (!blas || !blas->nodes)
+		return (aabb_create(instance->position, instance->position));
+	root = bvh_flat_bounds(&blas->nodes[0]);
+	i = 0;
+	while (i < 8)
+	{
+		corner = vec3_add(instance->position, vec3_multiply(
+					to_world(instance, box_corner(root, i)), instance->scale));
+		if (i++ == 0)
+			box = aabb_create(corner, corner);
+		else
+			box = aabb_merge(box, aabb_create(corner, corner));
+	}
+	return (box);
+}
+
+/* Cache the world box of every instance in box_min / box_max */
+void	scene_update_instances(t_scene *scene)
+{
+	t_instance	*instance;
+	t_aabb		box;
+	int			i;
+
+	i = 0;
+	while (i < scene->instance_count)
+	{
+		instance = &scene->instances[i++];
+		box = placed_bounds(scene, instance);
+		instance->box_min = box.min;
+		instance->box_max = box.max;
+	}
+}
+
+/*
+** ray taken into group space: the origin through the inverse
+** transform, the direction only rotated, so group-space distance t is
+** world distance t * scale.
+*/
+static t_ray	to_group_ray(const t_instance *instance, t_ray *ray)
+{
+	t_ray	local;
+
+	local.origin = vec3_multiply(to_group(instance, vec3_subtract(
+					ray->origin, instance->position)), 1 / instance->scale);
+	local.direction = to_group(instance, ray->direction);
+	ray_prepare(&local);
+	return (local);
+}
+
+/*
+** Closest hit of ray with an instance, in world space: the group-space
+** ray walks the group's BVH. Like intersect_*, only hits closer than
+** hit->distance are accepted.
+*/
+int	instance_intersect(t_scene *scene, const t_instance *instance,
+		t_ray *ray, t_hit *hit)
+{
+	t_scene	*objects;
+	t_ray	local;
+	t_hit	local_hit;
+	t_real	t;
+
+	objects = scene->groups[instance->group].objects;
+	if (!objects->render_state.bvh || !objects->render_state.bvh->nodes)
+		return (0);
+	local = to_group_ray(instance, ray);
+	local_hit.distance = hit->distance / instance->scale;
+	if (!bvh_intersect(objects->render_state.bvh, local, &local_hit, objects))
+		return (0);
+	t = local_hit.distance * instance->scale;
+	if (t >= hit->distance)
+		return (0);
+	*hit = local_hit;
+	hit->distance = t;
+	hit->point = vec3_add(ray->origin, vec3_multiply(ray->direction, t));
+	hit->normal = to_world(instance, local_hit.normal);
+	return (1);
+}
+
+/* Any-hit form for shadow rays: the group's BVH occlusion walk */
+int	instance_occludes(t_scene *scene, const t_instance *instance,
+		t_ray *ray, t_real max_distance)
+{
+	t_scene	*objects;
+
+	objects = scene->groups[instance->group].objects;
+	return (bvh_occluded(objects->render_state.bvh,
+			to_group_ray(instance, ray), max_distance / instance->scale,
+			objects));
+}
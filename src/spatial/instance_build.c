@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   instance_build.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:40:12 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 10:40:12 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "spatial.h"
+#include <stdio.h>
+
+/*
+** Build the bottom-level BVH of every group that has none yet, with
+** the scene's builder settings, then place the instance bounds the
+** scene BVH is built over. Group trees are neither cached nor reported
+** on their own: the scene tree above them is, and its hash covers them
+** through the instance bounds.
+*/
+void	scene_build_groups(t_scene *scene)
+{
+	t_scene	*objects;
+	int		i;
+
+	i = 0;
+	while (i < scene->group_count)
+	{
+		objects = scene->groups[i].objects;
+		if (!objects->render_state.bvh)
+		{
+			objects->render_state.bvh_config
+				= scene->render_state.bvh_config;
+			objects->render_state.bvh_config.cache = 0;
+			objects->render_state.bvh_config.stats = 0;
+			scene_build_bvh(objects);
+		}
+		i++;
+	}
+	scene_update_instances(scene);
+}
+
+/*
+** One line under the BVH report for instanced scenes: the placements
+** against the unique geometry they share, which is all that memory
+** and bottom-level build time scale with.
+*/
+void	scene_report_instances(t_scene *scene)
+{
+	t_scene	*group;
+	int		objects;
+	int		triangles;
+	int		nodes;
+	int		i;
+
+	if (scene->instance_count == 0)
+		return ;
+	objects = 0;
+	triangles = 0;
+	nodes = 0;
+	i = 0;
+	while (i < scene->group_count)
+	{
+		group = scene->groups[i++].objects;
+		triangles += group->triangle_count;
+		if (group->render_state.bvh && group->render_state.bvh->nodes)
+		{
+			objects += group->render_state.bvh->prim_count;
+			nodes += group->render_state.bvh->total_nodes;
+		}
+	}
+	printf("Instances: %d of %d groups, %d unique objects (%d triangles), "
+		"%d BLAS nodes\n", scene->instance_count, scene->group_count,
+		objects, triangles, nodes);
+}
+
+/*
+** Bytes held by the groups' bottom-level BVHs, which every backend
+** walks through once a ray enters an instance.
+*/
+size_t	scene_group_bytes(t_scene *scene)
+{
+	t_bvh	*bvh;
+	size_t	bytes;
+	int		i;
+
+	bytes = 0;
+	i = 0;
+	while (i < scene->group_count)
+	{
+		bvh = scene->groups[i++].objects->render_state.bvh;
+		if (bvh && bvh->nodes)
+			bytes += bvh_memory_bytes(bvh);
+	}
+	return (bytes);
+}
@@ -0,0 +1,292 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   octree_build.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:37:52 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 14:37:52 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "accel.h"
+#include <stdlib.h>
+
+/* Objects being sorted into the tree and their bounds, by index */
+typedef struct s_octree_ctx
+{
+	t_octree		*tree;
+	t_object_ref	*refs;
+	t_aabb			*boxes;
+}	t_octree_ctx;
+
+/* One node to fill: items[0 .. count) index the context's objects */
+typedef struct s_octree_task
+{
+	int	node;
+	int	*items;
+	int	count;
+	int	depth;
+}	t_octree_task;
+
+static int	octree_node(t_octree_ctx *ctx, t_octree_task *task);
+
+/*
+** Append count empty leaves, growing the node array; bounds are the
+** caller's to set. Returns the index of the first, -1 on allocation
+** failure.
+*/
+static int	push_nodes(t_octree *tree, int count)
+{
+	t_octree_node	*grown;
+	int				first;
+
+	if (tree->node_count + count > tree->node_capacity)
+	{
+		tree->node_capacity = tree->node_capacity * 2 + count;
+		grown = realloc(tree->nodes, sizeof(t_octree_node)
+				* tree->node_capacity);
+		if (!grown)
+			return (-1);
+		tree->nodes = grown;
+	}
+	first = tree->node_count;
+	while (tree->node_count < first + count)
+	{
+		tree->nodes[tree->node_count].child = -1;
+		tree->nodes[tree->node_count].offset = 0;
+		tree->nodes[tree->node_count].count = 0;
+		tree->node_count++;
+	}
+	return (first);
+}
+
+/* Make task's node a leaf over its items */
+static int	octree_leaf(t_octree_ctx *ctx, t_octree_task *task)
+{
+	t_octree		*tree;
+	t_object_ref	*grown;
+	int				i;
+
+	tree = ctx->tree;
+	if (tree->ref_count + task->count > tree->ref_capacity)
+	{
+		tree->ref_capacity = tree->ref_capacity * 2 + task->count;
+		grown = realloc(tree->refs, sizeof(t_object_ref)
+				* tree->ref_capacity);
+		if (!grown)
+			return (0);
+		tree->refs = grown;
+	}
+	tree->nodes[task->node].offset = tree->ref_count;
+	tree->nodes[task->node].count = task->count;
+	i = 0;
+	while (i < task->count)
+		tree->refs[tree->ref_count++] = ctx->refs[task->items[i++]];
+	tree->leaves++;
+	if (task->depth > tree->depth)
+		tree->depth = task->depth;
+	return (1);
+}
+
+/* Octant of box: bit 0 / 1 / 2 picks the upper half in x / y / z */
+static t_aabb	octant_box(t_aabb box, int octant)
+{
+	t_vec3	mid;
+
+	mid = vec3_multiply(vec3_add(box.min, box.max), 0.5);
+	if (octant & 1)
+		box.min.x = mid.x;
+	else
+		box.max.x = mid.x;
+	if (octant & 2)
+		box.min.y = mid.y;
+	else
+		box.max.y = mid.y;
+	if (octant & 4)
+		box.min.z = mid.z;
+	else
+		box.max.z = mid.z;
+	return (box);
+}
+
+/* Bit o set when box overlaps octant o of a node split at mid */
+static int	octant_mask(t_aabb *box, t_vec3 mid)
+{
+	int	sides[3];
+	int	mask;
+	int	octant;
+
+	sides[0] = (box->min.x <= mid.x) | (box->max.x >= mid.x) << 1;
+	sides[1] = (box->min.y <= mid.y) | (box->max.y >= mid.y) << 1;
+	sides[2] = (box->min.z <= mid.z) | (box->max.z >= mid.z) << 1;
+	mask = 0;
+	octant = 0;
+	while (octant < 8)
+	{
+		if ((sides[0] >> (octant & 1) & 1)
+			&& (sides[1] >> (octant >> 1 & 1) & 1)
+			&& (sides[2] >> (octant >> 2) & 1))
+			mask |= 1 << octant;
+		octant++;
+	}
+	return (mask);
+}
+
+/*
+** Octants each item of task overlaps. Returns 0 when some octant
+** would get every item (objects larger than the node, or all of them
+** straddling its center): splitting would only duplicate references.
+*/
+static int	octant_masks(t_octree_ctx *ctx, t_octree_task *task,
+		unsigned char *masks)
+{
+	t_aabb	*box;
+	t_vec3	mid;
+	int		common;
+	int		i;
+
+	box = &ctx->tree->nodes[task->node].bounds;
+	mid = vec3_multiply(vec3_add(box->min, box->max), 0.5);
+	common = 0xFF;
+	i = 0;
+	while (i < task->count)
+	{
+		masks[i] = octant_mask(&ctx->boxes[task->items[i]], mid);
+		common &= masks[i];
+		i++;
+	}
+	return (common == 0);
+}
+
+/*
+** Give each octant of task's node the items overlapping it, as eight
+** new children. sub_items has room for all of task's items and is
+** reused by one child after the other.
+*/
+static int	octree_children(t_octree_ctx *ctx, t_octree_task *task,
+		unsigned char *masks, int *sub_items)
+{
+	t_octree_task	sub;
+	int				first;
+	int				i;
+
+	first = push_nodes(ctx->tree, 8);
+	if (first < 0)
+		return (0);
+	ctx->tree->nodes[task->node].child = first;
+	sub.items = sub_items;
+	sub.depth = task->depth + 1;
+	sub.node = first - 1;
+	while (++sub.node < first + 8)
+	{
+		ctx->tree->nodes[sub.node].bounds = octant_box(
+				ctx->tree->nodes[task->node].bounds, sub.node - first);
+		sub.count = 0;
+		i = -1;
+		while (++i < task->count)
+			if (masks[i] >> (sub.node - first) & 1)
+				sub.items[sub.count++] = task->items[i];
+		if (sub.count > 0 && !octree_node(ctx, &sub))
+			return (0);
+	}
+	return (1);
+}
+
+/* Split task's node until it is small, too deep or stops shrinking */
+static int	octree_node(t_octree_ctx *ctx, t_octree_task *task)
+{
+	unsigned char	*masks;
+	int				*sub_items;
+	int				ok;
+
+	if (task->count <= OCTREE_LEAF_SIZE || task->depth >= OCTREE_MAX_DEPTH)
+		return (octree_leaf(ctx, task));
+	masks = malloc(task->count);
+	sub_items = malloc(sizeof(int) * task->count);
+	ok = masks && sub_items;
+	if (ok && !octant_masks(ctx, task, masks))
+		ok = octree_leaf(ctx, task);
+	else if (ok)
+		ok = octree_children(ctx, task, masks, sub_items);
+	free(masks);
+	free(sub_items);
+	return (ok);
+}
+
+/*
+** Bounds of every object, and a root cube around all of them so the
+** octants stay cubes at every depth.
+*/
+static void	octree_root(t_octree_ctx *ctx, t_octree_task *root,
+		t_scene *scene)
+{
+	t_aabb	box;
+	t_vec3	center;
+	t_real	half;
+	int		i;
+
+	i = -1;
+	while (++i < root->count)
+	{
+		root->items[i] = i;
+		ctx->boxes[i] = get_object_bounds(ctx->refs[i], scene);
+		if (i == 0)
+			box = ctx->boxes[0];
+		box = aabb_merge(box, ctx->boxes[i]);
+	}
+	center = vec3_multiply(vec3_add(box.min, box.max), 0.5);
+	half = box.max.x - box.min.x;
+	if (box.max.y - box.min.y > half)
+		half = box.max.y - box.min.y;
+	if (box.max.z - box.min.z > half)
+		half = box.max.z - box.min.z;
+	half = half * 0.5 + RAY_T_MIN;
+	ctx->tree->nodes[0].bounds.min = vec3_subtract(center,
+			(t_vec3){half, half, half});
+	ctx->tree->nodes[0].bounds.max = vec3_add(center,
+			(t_vec3){half, half, half});
+}
+
+/*
+** Sparse octree over count objects: only nodes holding more than
+** OCTREE_LEAF_SIZE objects are subdivided. Returns NULL on allocation
+** failure.
+*/
+t_octree	*octree_build(t_object_ref *refs, int count, t_scene *scene)
+{
+	t_octree_ctx	ctx;
+	t_octree_task	root;
+	int				ok;
+
+	ctx.tree = calloc(1, sizeof(t_octree));
+	ctx.refs = refs;
+	ctx.boxes = malloc(sizeof(t_aabb) * count);
+	root = (t_octree_task){0, malloc(sizeof(int) * count), count, 0};
+	ok = ctx.tree && ctx.boxes && root.items && push_nodes(ctx.tree, 1) == 0;
+	if (ok)
+	{
+		octree_root(&ctx, &root, scene);
+		ok = octree_node(&ctx, &root);
+	}
+	free(ctx.boxes);
+	free(root.items);
+	if (!ok)
+	{
+		octree_destroy(ctx.tree);
+		return (NULL);
+	}
+	ctx.tree->object_count = count;
+	return (ctx.tree);
+}
+
+void	octree_destroy(t_octree *tree)
+{
+	if (!tree)
+		return ;
+	free(tree->nodes);
+	free(tree->refs);
+	free(tree);
+}
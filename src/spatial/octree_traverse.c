@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   octree_traverse.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:58:30 by yoshin            #+#    #+#             */
+/*   Updated: 2026/10/17 14:58:30 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "accel.h"
+
+/*
+** One query: order is the octant flipped toward the ray (bit set
+** where the direction is negative), so children taken as
+** i ^ order for i = 0 .. 7 come nearest first.
+*/
+typedef struct s_octree_query
+{
+	t_octree	*tree;
+	t_scene		*scene;
+	t_ray		*ray;
+	int			order;
+	int			any;
+}	t_octree_query;
+
+/* Box test of node, clipped to the closest hit so far */
+static int	octree_box_hit(t_octree_node *node, t_ray *ray, t_real closest)
+{
+	t_real	t_min;
+	t_real	t_max;
+
+	t_min = 0;
+	t_max = closest;
+	return (aabb_intersect(&node->bounds, ray, &t_min, &t_max));
+}
+
+/* Objects of a leaf; with any, stop at the first occluder */
+static int	octree_leaf_hit(t_octree_query *q, t_octree_node *node,
+		t_hit *hit)
+{
+	t_object_ref	*refs;
+	int				found;
+	int				i;
+
+	refs = q->tree->refs + node->offset;
+	found = 0;
+	i = 0;
+	while (i < node->count)
+	{
+		if (q->any && bvh_occlude_object(refs[i], q->ray, hit->distance,
+				q->scene))
+			return (1);
+		if (!q->any && bvh_intersect_object(refs[i], q->ray, hit,
+				q->scene))
+			found = 1;
+		i++;
+	}
+	return (found);
+}
+
+/* Push the non-empty children of node, farthest first */
+static int	octree_push_children(t_octree_query *q, t_octree_node *node,
+		int *stack, int top)
+{
+	t_octree_node	*child;
+	int				i;
+
+	i = 8;
+	while (i-- > 0)
+	{
+		child = &q->tree->nodes[node->child + (i ^ q->order)];
+		if (child->child >= 0 || child->count > 0)
+			stack[top++] = node->child + (i ^ q->order);
+	}
+	return (top);
+}
+
+/*
+** Front-to-back walk; hit->distance prunes every node entered beyond
+** the closest hit so far. Objects in several leaves may be tested
+** more than once.
+*/
+static int	octree_walk(t_octree_query *q, t_hit *hit)
+{
+	int				stack[OCTREE_STACK_SIZE];
+	t_octree_node	*node;
+	int				top;
+	int				found;
+
+	found = 0;
+	stack[0] = 0;
+	top = 1;
+	while (top > 0)
+	{
+		node = &q->tree->nodes[stack[--top]];
+		if (octree_box_hit(node, q->ray, hit->distance))
+		{
+			if (node->child < 0)
+				found |= octree_leaf_hit(q, node, hit);
+			else
+				top = octree_push_children(q, node, stack, top);
+			if (found && q->any)
+				return (1);
+		}
+	}
+	return (found);
+}
+
+/* Closest hit below hit->distance; ray must be prepared */
+int	octree_intersect(t_octree *tree, t_scene *scene, t_ray *ray,
+		t_hit *hit)
+{
+	t_octree_query	q;
+
+	if (!tree)
+		return (0);
+	q = (t_octree_query){tree, scene, ray,
+		ray->sign[0] | ray->sign[1] << 1 | ray->sign[2] << 2, 0};
+	return (octree_walk(&q, hit));
+}
+
+/* 1 if any object lies closer than max_distance; ray must be prepared */
+int	octree_occluded(t_octree *tree, t_scene *scene, t_ray *ray,
+		t_real max_distance)
+{
+	t_octree_query	q;
+	t_hit			hit;
+
+	if (!tree)
+		return (0);
+	q = (t_octree_query){tree, scene, ray,
+		ray->sign[0] | ray->sign[1] << 1 | ray->sign[2] << 2, 1};
+	hit.distance = max_distance;
+	return (octree_walk(&q, &hit));
+}
@@ -23,12 +23,14 @@ void	cleanup_scene(t_scene *scene)
 	if (!scene)
 		return ;
 	render_state_cleanup(&scene->render_state);
+	scene_free_objects(scene);
 	free(scene);
 }
 
 /*
 ** Free memory allocated for render context.
-** Destroys MLX image buffer and frees render structure.
+** Stops render workers, destroys MLX image buffer and frees render.
+** Headless contexts own a plain malloc'd framebuffer instead.
 */
 void	cleanup_render(void *param)
 {
@@ -37,8 +39,11 @@ void	cleanup_render(void *param)
 	render = (t_render *)param;
 	if (!render)
 		return ;
+	render_pool_destroy(render->pool);
 	if (render->img && render->mlx)
 		mlx_destroy_image(render->mlx, render->img);
+	else if (!render->img)
+		free(render->img_data);
 	free(render);
 }
 
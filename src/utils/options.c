@@ -0,0 +1,296 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/05 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/05 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "options.h"
+#include "render_pool.h"
+#include "packet.h"
+#include "spatial.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void	print_usage(const char *program)
+{
+	printf("Usage: %s [options] <scene_file.rt>\n", program);
+	printf("       %s --batch DIR [--manifest FILE] [scene.rt ...]\n",
+		program);
+	printf("  --threads N      render threads (default: one per CPU)\n");
+	printf("  --output FILE    render once to FILE (.ppm or .png) "
+		"without opening a window\n");
+	printf("  --batch DIR      render every scene offline into DIR\n");
+	printf("  --manifest FILE  batch scene list, one path per line\n");
+	printf("  --simd MODE      primary ray packets: auto (default), "
+		"avx2, sse or off\n");
+	printf("  --accel A        acceleration structure: bvh (default), grid, "
+		"octree or none\n");
+	printf("  --bvh-builder B  BVH splits: sah (default) or midpoint\n");
+	printf("  --bvh-traversal T  BVH walk: ordered (default) or recursive\n");
+	printf("  --bvh-width W    ordered BVH walk branching: 2 (default), 4 "
+		"or 8\n");
+	printf("  --bvh-threads N  BVH build threads (default: one per CPU)\n");
+	printf("  --bvh-cache      reuse the BVH saved in <scene>.rt.bvh when "
+		"the scene is unchanged\n");
+	printf("  --bvh-stats      print build time, memory, probe cost and "
+		"BVH quality\n                   after the build\n");
+}
+
+/*
+** Check that str is a non-empty run of decimal digits.
+*/
+static int	is_number(const char *str)
+{
+	if (!str || !*str)
+		return (0);
+	while (*str >= '0' && *str <= '9')
+		str++;
+	return (*str == '\0');
+}
+
+/*
+** Parse "--threads N". Accepts 1..RENDER_MAX_THREADS.
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_threads(int argc, char **argv, int i, t_options *opts)
+{
+	if (i + 1 >= argc || !is_number(argv[i + 1]))
+		return (print_error("--threads expects a positive number"));
+	opts->thread_count = ft_atoi(argv[i + 1]);
+	if (opts->thread_count < 1 || opts->thread_count > RENDER_MAX_THREADS)
+		return (print_error("--threads out of range"));
+	return (2);
+}
+
+/*
+** Parse "--simd auto|avx2|sse|off".
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_simd(int argc, char **argv, int i, t_options *opts)
+{
+	const char	*mode;
+
+	mode = "";
+	if (i + 1 < argc)
+		mode = argv[i + 1];
+	if (strcmp(mode, "auto") == 0)
+		opts->simd = SIMD_AUTO;
+	else if (strcmp(mode, "avx2") == 0)
+		opts->simd = SIMD_AVX2;
+	else if (strcmp(mode, "sse") == 0)
+		opts->simd = SIMD_SSE;
+	else if (strcmp(mode, "off") == 0)
+		opts->simd = SIMD_OFF;
+	else
+		return (print_error("--simd expects auto, avx2, sse or off"));
+	return (2);
+}
+
+/*
+** Parse "--accel bvh|grid|octree|none".
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_accel(int argc, char **argv, int i, t_options *opts)
+{
+	opts->accel = -1;
+	if (i + 1 < argc)
+		opts->accel = accel_parse(argv[i + 1]);
+	if (opts->accel < 0)
+		return (print_error("--accel expects bvh, grid, octree or none"));
+	return (2);
+}
+
+/*
+** Parse "--bvh-builder sah|midpoint".
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_bvh_builder(int argc, char **argv, int i, t_options *opts)
+{
+	if (i + 1 < argc && strcmp(argv[i + 1], "sah") == 0)
+		opts->bvh.builder = BVH_BUILDER_SAH;
+	else if (i + 1 < argc && strcmp(argv[i + 1], "midpoint") == 0)
+		opts->bvh.builder = BVH_BUILDER_MIDPOINT;
+	else
+		return (print_error("--bvh-builder expects sah or midpoint"));
+	return (2);
+}
+
+/*
+** Parse "--bvh-traversal ordered|recursive".
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_bvh_traversal(int argc, char **argv, int i, t_options *opts)
+{
+	if (i + 1 < argc && strcmp(argv[i + 1], "ordered") == 0)
+		opts->bvh.traversal = BVH_TRAVERSAL_ORDERED;
+	else if (i + 1 < argc && strcmp(argv[i + 1], "recursive") == 0)
+		opts->bvh.traversal = BVH_TRAVERSAL_RECURSIVE;
+	else
+		return (print_error("--bvh-traversal expects ordered or recursive"));
+	return (2);
+}
+
+/*
+** Parse "--bvh-width 2|4|8".
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_bvh_width(int argc, char **argv, int i, t_options *opts)
+{
+	if (i + 1 < argc && strcmp(argv[i + 1], "2") == 0)
+		opts->bvh.width = 2;
+	else if (i + 1 < argc && strcmp(argv[i + 1], "4") == 0)
+		opts->bvh.width = 4;
+	else if (i + 1 < argc && strcmp(argv[i + 1], "8") == 0)
+		opts->bvh.width = 8;
+	else
+		return (print_error("--bvh-width expects 2, 4 or 8"));
+	return (2);
+}
+
+/*
+** Parse "--bvh-threads N". Accepts 1..RENDER_MAX_THREADS.
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_bvh_threads(int argc, char **argv, int i, t_options *opts)
+{
+	if (i + 1 >= argc || !is_number(argv[i + 1]))
+		return (print_error("--bvh-threads expects a positive number"));
+	opts->bvh.threads = ft_atoi(argv[i + 1]);
+	if (opts->bvh.threads < 1 || opts->bvh.threads > RENDER_MAX_THREADS)
+		return (print_error("--bvh-threads out of range"));
+	return (2);
+}
+
+/*
+** Switches without a value ("--bvh-cache", "--bvh-stats").
+** Returns number of arguments consumed.
+*/
+static int	parse_flag(int *flag)
+{
+	*flag = 1;
+	return (1);
+}
+
+/*
+** Parse an option taking a path ("--output FILE", "--batch DIR", ...).
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_path(int argc, char **argv, int i, const char **dst)
+{
+	if (i + 1 >= argc || !*argv[i + 1])
+		return (print_error("Option expects a path argument"));
+	*dst = argv[i + 1];
+	return (2);
+}
+
+/*
+** Dispatch one "--bvh-*" option.
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_bvh_option(int argc, char **argv, int i, t_options *opts)
+{
+	if (strcmp(argv[i], "--bvh-builder") == 0)
+		return (parse_bvh_builder(argc, argv, i, opts));
+	if (strcmp(argv[i], "--bvh-traversal") == 0)
+		return (parse_bvh_traversal(argc, argv, i, opts));
+	if (strcmp(argv[i], "--bvh-width") == 0)
+		return (parse_bvh_width(argc, argv, i, opts));
+	if (strcmp(argv[i], "--bvh-threads") == 0)
+		return (parse_bvh_threads(argc, argv, i, opts));
+	if (strcmp(argv[i], "--bvh-cache") == 0)
+		return (parse_flag(&opts->bvh.cache));
+	if (strcmp(argv[i], "--bvh-stats") == 0)
+		return (parse_flag(&opts->bvh.stats));
+	return (print_error("Unknown option"));
+}
+
+/*
+** Dispatch a single argument. Options start with "--", anything
+** else is a scene file.
+** Returns number of arguments consumed, 0 on error.
+*/
+static int	parse_argument(int argc, char **argv, int i, t_options *opts)
+{
+	if (strcmp(argv[i], "--threads") == 0)
+		return (parse_threads(argc, argv, i, opts));
+	if (strcmp(argv[i], "--simd") == 0)
+		return (parse_simd(argc, argv, i, opts));
+	if (strcmp(argv[i], "--accel") == 0)
+		return (parse_accel(argc, argv, i, opts));
+	if (strncmp(argv[i], "--bvh-", 6) == 0)
+		return (parse_bvh_option(argc, argv, i, opts));
+	if (strcmp(argv[i], "--output") == 0)
+		return (parse_path(argc, argv, i, &opts->output_file));
+	if (strcmp(argv[i], "--batch") == 0)
+		return (parse_path(argc, argv, i, &opts->batch_dir));
+	if (strcmp(argv[i], "--manifest") == 0)
+		return (parse_path(argc, argv, i, &opts->manifest));
+	if (strncmp(argv[i], "--", 2) == 0)
+		return (print_error("Unknown option"));
+	opts->scene_files[opts->scene_count++] = argv[i];
+	if (!opts->scene_file)
+		opts->scene_file = argv[i];
+	return (1);
+}
+
+/*
+** Interactive and --output modes take exactly one scene file;
+** batch mode takes any number plus an optional manifest.
+*/
+static int	check_mode(t_options *opts)
+{
+	if (opts->batch_dir)
+	{
+		if (opts->output_file)
+			return (print_error("--output cannot be used with --batch"));
+		if (opts->scene_count == 0 && !opts->manifest)
+			return (print_error("--batch needs scene files or --manifest"));
+		return (1);
+	}
+	if (opts->manifest)
+		return (print_error("--manifest requires --batch"));
+	if (opts->scene_count > 1)
+		return (print_error("Only one scene file may be given"));
+	return (opts->scene_count == 1);
+}
+
+int	parse_options(int argc, char **argv, t_options *opts)
+{
+	int	i;
+	int	used;
+
+	memset(opts, 0, sizeof(t_options));
+	opts->accel = ACCEL_BVH;
+	opts->bvh.width = BVH_DEFAULT_WIDTH;
+	opts->scene_files = malloc(sizeof(char *) * argc);
+	if (!opts->scene_files)
+		return (print_error("Out of memory"));
+	i = 1;
+	used = 1;
+	while (i < argc && used)
+	{
+		used = parse_argument(argc, argv, i, opts);
+		i += used;
+	}
+	if (!used || !check_mode(opts))
+	{
+		options_cleanup(opts);
+		return (0);
+	}
+	return (1);
+}
+
+void	options_cleanup(t_options *opts)
+{
+	free(opts->scene_files);
+	opts->scene_files = NULL;
+	opts->scene_count = 0;
+}
@@ -0,0 +1,39 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scene_init.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/08 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/08 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** Initialize scene structure with default values.
+** Allocates memory and sets all counters to zero.
+** Returns NULL on allocation failure.
+*/
+t_scene	*init_scene(void)
+{
+	t_scene	*scene;
+
+	scene = malloc(sizeof(t_scene));
+	if (!scene)
+		return (NULL);
+	memset(scene, 0, sizeof(t_scene));
+	scene->sphere_count = 0;
+	scene->plane_count = 0;
+	scene->cylinder_count = 0;
+	scene->has_ambient = 0;
+	scene->has_camera = 0;
+	scene->has_light = 0;
+	scene->shadow_config = init_shadow_config();
+	render_state_init(&scene->render_state);
+	return (scene);
+}
@@ -0,0 +1,221 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   scene_storage.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: yoshin <yoshin@student.42gyeongsan.kr>     +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/20 10:00:00 by yoshin            #+#    #+#             */
+/*   Updated: 2026/01/20 10:00:00 by yoshin           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+** Growable object arrays. Capacity starts at SCENE_INITIAL_CAPACITY
+** and doubles, so parsing n objects costs O(n) copies in total and
+** every capacity stays a multiple of the 8-lane sphere SIMD block.
+** Objects are only added while parsing, before anything keeps a
+** pointer into the arrays. Mesh vertices and triangles grow the same
+** way while an OBJ file streams in.
+*/
+
+/* Resize *array to capacity elements, zeroing the new tail */
+static int	grow(void **array, int old_capacity, int capacity, size_t size)
+{
+	void	*grown;
+
+	grown = realloc(*array, size * capacity);
+	if (!grown)
+		return (0);
+	memset((char *)grown + size * old_capacity, 0,
+		size * (capacity - old_capacity));
+	*array = grown;
+	return (1);
+}
+
+static int	next_capacity(int capacity)
+{
+	if (capacity == 0)
+		return (SCENE_INITIAL_CAPACITY);
+	return (capacity * 2);
+}
+
+int	scene_reserve_sphere(t_scene *scene)
+{
+	t_sphere_soa	*soa;
+	int				old;
+	int				cap;
+
+	if (scene->sphere_count < scene->sphere_capacity)
+		return (1);
+	soa = &scene->sphere_soa;
+	old = scene->sphere_capacity;
+	cap = next_capacity(old);
+	if (!grow((void **)&scene->spheres, old, cap, sizeof(t_sphere))
+		|| !grow((void **)&soa->cx, old, cap, sizeof(t_real))
+		|| !grow((void **)&soa->cy, old, cap, sizeof(t_real))
+		|| !grow((void **)&soa->cz, old, cap, sizeof(t_real))
+		|| !grow((void **)&soa->r2, old, cap, sizeof(t_real)))
+		return (0);
+	scene->sphere_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_plane(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->plane_count < scene->plane_capacity)
+		return (1);
+	cap = next_capacity(scene->plane_capacity);
+	if (!grow((void **)&scene->planes, scene->plane_capacity, cap,
+			sizeof(t_plane)))
+		return (0);
+	scene->plane_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_cylinder(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->cylinder_count < scene->cylinder_capacity)
+		return (1);
+	cap = next_capacity(scene->cylinder_capacity);
+	if (!grow((void **)&scene->cylinders, scene->cylinder_capacity, cap,
+			sizeof(t_cylinder)))
+		return (0);
+	scene->cylinder_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_vertex(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->vertex_count < scene->vertex_capacity)
+		return (1);
+	cap = next_capacity(scene->vertex_capacity);
+	if (!grow((void **)&scene->vertices, scene->vertex_capacity, cap,
+			sizeof(t_vertex)))
+		return (0);
+	scene->vertex_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_triangle(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->triangle_count < scene->triangle_capacity)
+		return (1);
+	cap = next_capacity(scene->triangle_capacity);
+	if (!grow((void **)&scene->triangles, scene->triangle_capacity, cap,
+			sizeof(t_triangle)))
+		return (0);
+	scene->triangle_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_mesh(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->mesh_count < scene->mesh_capacity)
+		return (1);
+	cap = next_capacity(scene->mesh_capacity);
+	if (!grow((void **)&scene->meshes, scene->mesh_capacity, cap,
+			sizeof(t_mesh)))
+		return (0);
+	scene->mesh_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_group(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->group_count < scene->group_capacity)
+		return (1);
+	cap = next_capacity(scene->group_capacity);
+	if (!grow((void **)&scene->groups, scene->group_capacity, cap,
+			sizeof(t_group)))
+		return (0);
+	scene->group_capacity = cap;
+	return (1);
+}
+
+int	scene_reserve_instance(t_scene *scene)
+{
+	int	cap;
+
+	if (scene->instance_count < scene->instance_capacity)
+		return (1);
+	cap = next_capacity(scene->instance_capacity);
+	if (!grow((void **)&scene->instances, scene->instance_capacity, cap,
+			sizeof(t_instance)))
+		return (0);
+	scene->instance_capacity = cap;
+	return (1);
+}
+
+static void	free_meshes(t_scene *scene)
+{
+	free(scene->vertices);
+	free(scene->triangles);
+	free(scene->meshes);
+	scene->vertices = NULL;
+	scene->triangles = NULL;
+	scene->meshes = NULL;
+	scene->vertex_count = 0;
+	scene->triangle_count = 0;
+	scene->mesh_count = 0;
+	scene->vertex_capacity = 0;
+	scene->triangle_capacity = 0;
+	scene->mesh_capacity = 0;
+}
+
+/* Groups own their scenes; the instances only point at them by index */
+static void	free_groups(t_scene *scene)
+{
+	int	i;
+
+	i = 0;
+	while (i < scene->group_count)
+		cleanup_scene(scene->groups[i++].objects);
+	free(scene->groups);
+	free(scene->instances);
+	scene->groups = NULL;
+	scene->instances = NULL;
+	scene->group_count = 0;
+	scene->group_capacity = 0;
+	scene->instance_count = 0;
+	scene->instance_capacity = 0;
+}
+
+void	scene_free_objects(t_scene *scene)
+{
+	free_meshes(scene);
+	free_groups(scene);
+	free(scene->spheres);
+	free(scene->sphere_soa.cx);
+	free(scene->sphere_soa.cy);
+	free(scene->sphere_soa.cz);
+	free(scene->sphere_soa.r2);
+	free(scene->planes);
+	free(scene->cylinders);
+	memset(&scene->sphere_soa, 0, sizeof(t_sphere_soa));
+	scene->spheres = NULL;
+	scene->planes = NULL;
+	scene->cylinders = NULL;
+	scene->sphere_count = 0;
+	scene->plane_count = 0;
+	scene->cylinder_count = 0;
+	scene->sphere_capacity = 0;
+	scene->plane_capacity = 0;
+	scene->cylinder_capacity = 0;
+}
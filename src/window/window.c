@@ -15,6 +15,7 @@
 #include "hud.h"
 #include "keyguide.h"
 #include "metrics.h"
+#include "spatial.h"
 #include <stdlib.h>
 #include <math.h>
 
@@ -58,6 +59,8 @@ void	render_scene_to_buffer(t_scene *scene, t_render *render);
 # define KEY_Q 12
 # define KEY_I 34
 # define KEY_H 4
+# define KEY_P 35
+# define KEY_M 46
 # define KEY_TAB 48
 # define KEY_SHIFT_L 56
 # define KEY_SHIFT_R 60
@@ -101,6 +104,8 @@ void	render_scene_to_buffer(t_scene *scene, t_render *render);
 # define KEY_Q 113
 # define KEY_I 105
 # define KEY_H 104
+# define KEY_P 112
+# define KEY_M 109
 # define KEY_TAB 65289
 # define KEY_SHIFT_L 65505
 # define KEY_SHIFT_R 65506
@@ -272,23 +277,37 @@ static void	handle_object_selection(t_render *render, int keycode)
 	hud_mark_dirty(render);
 }
 
-static void	move_selected_object(t_render *render, t_vec3 move)
+/*
+** Move the selected object. Bounded objects flag their BVH leaf and
+** the grid / octree; both are brought up to date before the next
+** frame (scene_update_accel). Returns 0 when nothing is selected.
+*/
+static int	move_selected_object(t_render *render, t_vec3 move)
 {
 	if (render->selection.type == OBJ_SPHERE
 		&& render->selection.index < render->scene->sphere_count)
+	{
 		render->scene->spheres[render->selection.index].center
 			= vec3_add(render->scene->spheres[render->selection.index].center,
 				move);
+		scene_sync_sphere(render->scene, render->selection.index);
+	}
 	else if (render->selection.type == OBJ_PLANE
 		&& render->selection.index < render->scene->plane_count)
+	{
 		render->scene->planes[render->selection.index].point
 			= vec3_add(render->scene->planes[render->selection.index].point,
 				move);
+		scene_sync_plane(render->scene, render->selection.index);
+	}
 	else if (render->selection.type == OBJ_CYLINDER
 		&& render->selection.index < render->scene->cylinder_count)
 		render->scene->cylinders[render->selection.index].center
 			= vec3_add(render->scene->cylinders[render->selection.index].center,
 				move);
+	else
+		return (0);
+	return (1);
 }
 
 static void	handle_object_move(t_render *render, int keycode)
@@ -312,7 +331,13 @@ static void	handle_object_move(t_render *render, int keycode)
 		move.z = step;
 	else
 		return ;
-	move_selected_object(render, move);
+	if (!move_selected_object(render, move))
+		return ;
+	accel_mark_dirty(render->scene, (t_object_ref){
+		render->selection.type, render->selection.index});
+	render->low_quality = 1;
+	render->dirty = 1;
+	hud_mark_dirty(render);
 }
 
 static void	handle_light_move(t_render *render, int keycode)
@@ -340,6 +365,42 @@ static void	handle_light_move(t_render *render, int keycode)
 			move);
 }
 
+/*
+** Toggle progressive rendering. The center-out tile order is built
+** on first use; either way the frame is re-rendered from scratch.
+*/
+static void	handle_progressive_toggle(t_render *render)
+{
+	t_progressive_state	*prog;
+
+	prog = &render->scene->render_state.progressive;
+	if (prog->enabled)
+		prog->enabled = 0;
+	else if (!prog->order)
+		progressive_init(prog, WINDOW_WIDTH, WINDOW_HEIGHT,
+			RENDER_TILE_SIZE);
+	else
+		prog->enabled = 1;
+	render->dirty = 1;
+	hud_mark_dirty(render);
+}
+
+/*
+** Cycle the acceleration structure (bvh, grid, octree, none), building
+** the next one on first use, and print its figures so backends can
+** be compared on the current scene.
+*/
+static void	handle_accel_cycle(t_render *render)
+{
+	t_scene	*scene;
+
+	scene = render->scene;
+	scene_select_accel(scene, (scene->render_state.accel + 1) % ACCEL_COUNT);
+	scene_report_accel(scene);
+	render->dirty = 1;
+	hud_mark_dirty(render);
+}
+
 /*
 ** Handle keyboard input events with interactive controls.
 ** Uses dirty flag and low quality rendering for smooth interaction.
@@ -389,12 +450,7 @@ int	handle_key(int keycode, void *param)
 		handle_object_selection(render, keycode);
 	else if (keycode == KEY_R || keycode == KEY_T || keycode == KEY_F
 		|| keycode == KEY_G || keycode == KEY_V || keycode == KEY_B)
-	{
 		handle_object_move(render, keycode);
-		render->low_quality = 1;
-		render->dirty = 1;
-		hud_mark_dirty(render);
-	}
 	else if (keycode == KEY_INSERT || keycode == KEY_HOME || keycode == KEY_PGUP
 		|| keycode == KEY_DELETE || keycode == KEY_END || keycode == KEY_PGDN)
 	{
@@ -403,6 +459,10 @@ int	handle_key(int keycode, void *param)
 		render->dirty = 1;
 		hud_mark_dirty(render);
 	}
+	else if (keycode == KEY_P)
+		handle_progressive_toggle(render);
+	else if (keycode == KEY_M)
+		handle_accel_cycle(render);
 	else if (keycode == KEY_I)
 	{
 		render->scene->render_state.show_info
@@ -441,13 +501,32 @@ int	handle_key_release(int keycode, void *param)
 
 /*
 ** Main rendering loop hook.
-** Only re-renders when dirty flag is set.
+** In progressive mode each tick renders one time-budgeted slice of
+** the current pass, and any change (dirty flag) restarts the pass.
+** Otherwise only re-renders the whole frame when dirty flag is set.
+** The HUD is drawn once the frame is complete.
 */
 int	render_loop(void *param)
 {
-	t_render	*render;
+	t_render			*render;
+	t_progressive_state	*prog;
 
 	render = (t_render *)param;
+	prog = &render->scene->render_state.progressive;
+	scene_update_accel(render->scene);
+	if (prog->enabled && render->dirty)
+	{
+		progressive_reset(prog);
+		metrics_start_frame(&render->scene->render_state.metrics);
+		render->dirty = 0;
+	}
+	if (prog->enabled && progressive_render_step(render))
+	{
+		metrics_end_frame(&render->scene->render_state.metrics);
+		hud_mark_dirty(render);
+	}
+	if (prog->enabled && prog->tiles_completed < prog->total_tiles)
+		return (0);
 	if (render->dirty)
 	{
 		metrics_start_frame(&render->scene->render_state.metrics);
@@ -499,6 +578,8 @@ t_render	*init_window(t_scene *scene)
 	render->dirty = 1;
 	render->low_quality = 0;
 	render->shift_pressed = 0;
+	render->pool = NULL;
+	render->packet = NULL;
 	if (hud_init(&render->hud, render->mlx, render->win) == -1)
 	{
 		free(render);
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_bvh_refit.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miniRT team <miniRT@42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:20:00 by miniRT           #+#    #+#             */
+/*   Updated: 2026/10/17 11:20:00 by miniRT          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "minirt.h"
+#include "spatial.h"
+#include "window.h"
+#include <stdio.h>
+#include <assert.h>
+
+#define GRID_X 20
+#define GRID_Y 10
+#define GRID_Z 10
+
+/* GRID_X * GRID_Y * GRID_Z small spheres two units apart */
+static t_scene	*grid_scene(void)
+{
+	t_scene		*scene;
+	t_sphere	*sphere;
+	int			i;
+
+	scene = init_scene();
+	assert(scene);
+	i = 0;
+	while (i < GRID_X * GRID_Y * GRID_Z)
+	{
+		assert(scene_reserve_sphere(scene));
+		sphere = &scene->spheres[i];
+		sphere->center = (t_vec3){i % GRID_X * 2.0,
+			i / GRID_X % GRID_Y * 2.0, i / (GRID_X * GRID_Y) * 2.0};
+		sphere->diameter = 1.0;
+		sphere->radius = 0.5;
+		sphere->radius_squared = 0.25;
+		scene_sync_sphere(scene, i);
+		scene->sphere_count = ++i;
+	}
+	scene_build_bvh(scene);
+	assert(scene->render_state.bvh && scene->render_state.bvh->nodes);
+	return (scene);
+}
+
+/* Move sphere index by dx, flag it and refit; returns bvh_refit's verdict */
+static int	move_sphere(t_scene *scene, int index, double dx)
+{
+	scene->spheres[index].center.x += dx;
+	scene_sync_sphere(scene, index);
+	bvh_mark_dirty(scene->render_state.bvh,
+		(t_object_ref){OBJ_SPHERE, index});
+	return (bvh_refit(scene->render_state.bvh, scene));
+}
+
+void	test_refit_small_move(void)
+{
+	t_scene	*scene;
+	t_bvh	*bvh;
+
+	printf("Testing bvh_refit with a small move...\n");
+	scene = grid_scene();
+	bvh = scene->render_state.bvh;
+	assert(move_sphere(scene, 0, 0.5) == 0);
+	assert(bvh->nodes[0].min[0] <= 0.0f);
+	assert(bvh->sah_sum > 0 && bvh->sah_sum < bvh->build_sum * 1.01);
+	assert(bvh->dirty_count == 0);
+	cleanup_scene(scene);
+	printf("✓ small move refits in place\n");
+}
+
+/*
+** Objects carried far outside the scene grow the root box with them,
+** so a cost divided by the current root area barely moves while every
+** box on their paths has become huge. The rebuild has to come from
+** the growth of the sum itself.
+*/
+void	test_refit_outward_move(void)
+{
+	t_scene	*scene;
+	t_bvh	*bvh;
+	int		moves;
+
+	printf("Testing bvh_refit with outward moves...\n");
+	scene = grid_scene();
+	bvh = scene->render_state.bvh;
+	moves = 0;
+	while (moves < 10 && !move_sphere(scene, moves * 197, 200.0))
+	{
+		assert(bvh->sah_sum <= bvh->build_sum * BVH_REFIT_MAX_GROWTH);
+		moves++;
+	}
+	assert(moves < 10);
+	assert(bvh->sah_sum > bvh->build_sum * BVH_REFIT_MAX_GROWTH);
+	printf("  rebuild requested after %d moves\n", moves + 1);
+	cleanup_scene(scene);
+	printf("✓ outward moves request a rebuild\n");
+}
+
+int	main(void)
+{
+	printf("\n=== BVH Refit Unit Tests ===\n\n");
+	test_refit_small_move();
+	test_refit_outward_move();
+	printf("\n=== All tests passed! ===\n\n");
+	return (0);
+}
@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   test_float_precision.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miniRT team <miniRT@42.fr>                +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/01/09 00:00:00 by miniRT           #+#    #+#             */
+/*   Updated: 2026/01/09 00:00:00 by miniRT          ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+/*
+** Compares a frame rendered by the double build (miniRT) with the same
+** frame from the float build (miniRT_float). Both are binary PPMs from
+** --output. scripts/test_float_precision.sh builds both variants and
+** runs this over the reference scenes.
+**
+** Tolerance: mean channel error below 0.5 levels and fewer than 0.5%
+** of pixels off by more than 8 levels (silhouette and shadow-edge
+** pixels may flip between precisions; the bulk of the image may not).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#define MAX_MEAN_ERROR 0.5
+#define PIXEL_THRESHOLD 8
+#define MAX_BAD_PIXELS 0.005
+
+typedef struct s_ppm
+{
+	int				width;
+	int				height;
+	unsigned char	*data;
+}	t_ppm;
+
+static int	load_ppm(const char *path, t_ppm *img)
+{
+	FILE	*file;
+	int		maxval;
+	size_t	size;
+
+	file = fopen(path, "rb");
+	if (!file)
+		return (0);
+	if (fscanf(file, "P6 %d %d %d", &img->width, &img->height, &maxval) != 3
+		|| maxval != 255 || fgetc(file) == EOF)
+	{
+		fclose(file);
+		return (0);
+	}
+	size = (size_t)img->width * img->height * 3;
+	img->data = malloc(size);
+	if (!img->data || fread(img->data, 1, size, file) != size)
+	{
+		fclose(file);
+		return (0);
+	}
+	fclose(file);
+	return (1);
+}
+
+static int	pixel_error(unsigned char *a, unsigned char *b)
+{
+	int	max;
+	int	d;
+	int	i;
+
+	max = 0;
+	i = 0;
+	while (i < 3)
+	{
+		d = abs(a[i] - b[i]);
+		if (d > max)
+			max = d;
+		i++;
+	}
+	return (max);
+}
+
+void	test_images_within_tolerance(t_ppm *ref, t_ppm *img)
+{
+	size_t	pixels;
+	size_t	bad;
+	double	sum;
+	size_t	i;
+
+	printf("Testing float vs double image difference...\n");
+	assert(ref->width == img->width && ref->height == img->height);
+	pixels = (size_t)ref->width * ref->height;
+	bad = 0;
+	sum = 0;
+	i = 0;
+	while (i < pixels * 3)
+	{
+		sum += abs(ref->data[i] - img->data[i]);
+		if (i % 3 == 0 && pixel_error(ref->data + i, img->data + i)
+			> PIXEL_THRESHOLD)
+			bad++;
+		i++;
+	}
+	printf("  mean error %.4f, pixels over threshold %.4f%%\n",
+		sum / (pixels * 3), 100.0 * bad / pixels);
+	assert(sum / (pixels * 3) <= MAX_MEAN_ERROR);
+	assert((double)bad / pixels <= MAX_BAD_PIXELS);
+	printf("✓ Images within tolerance\n");
+}
+
+int	main(int argc, char **argv)
+{
+	t_ppm	ref;
+	t_ppm	img;
+
+	if (argc != 3)
+	{
+		printf("Usage: %s <double.ppm> <float.ppm>\n", argv[0]);
+		return (1);
+	}
+	printf("\n=== Float Precision Test ===\n\n");
+	assert(load_ppm(argv[1], &ref));
+	assert(load_ppm(argv[2], &img));
+	test_images_within_tolerance(&ref, &img);
+	free(ref.data);
+	free(img.data);
+	printf("\n=== All tests passed! ===\n\n");
+	return (0);
+}
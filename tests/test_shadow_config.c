@@ -12,16 +12,37 @@
 
 #include "shadow.h"
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 #include <assert.h>
 
+/* Every active disk sample lies within the light radius softness * 2 */
+static int	disk_within_radius(const t_shadow_config *config)
+{
+	double	radius;
+	int		i;
+
+	radius = config->softness * 2.0 + 1e-9;
+	i = 0;
+	while (i < config->samples)
+	{
+		if (hypot(config->disk[i][0], config->disk[i][1]) > radius)
+			return (0);
+		i++;
+	}
+	return (1);
+}
+
 void	test_init_shadow_config(void)
 {
 	t_shadow_config	config;
 
 	printf("Testing init_shadow_config...\n");
 	config = init_shadow_config();
-	assert(config.samples == 4);
-	assert(config.softness == 0.1);
+	assert(config.samples == 16);
+	assert(config.softness == 0.3);
+	assert(config.probes == 5);
+	assert(disk_within_radius(&config));
 	assert(config.bias_scale == 2.0);
 	assert(config.enable_ao == 0);
 	printf("✓ init_shadow_config passed\n");
@@ -51,6 +72,7 @@ void	test_validate_shadow_config(void)
 void	test_set_shadow_samples(void)
 {
 	t_shadow_config	config;
+	int				n;
 
 	printf("Testing set_shadow_samples...\n");
 	config = init_shadow_config();
@@ -58,18 +80,38 @@ void	test_set_shadow_samples(void)
 	assert(config.samples == 16);
 	set_shadow_samples(&config, 0);
 	assert(config.samples == 16);
+	set_shadow_samples(&config, SHADOW_MAX_SAMPLES + 1);
+	assert(config.samples == 16);
 	set_shadow_samples(NULL, 8);
+	set_shadow_samples(&config, 1);
+	assert(config.samples == 1 && config.probes == 1);
+	assert(config.disk[0][0] == 0.0 && config.disk[0][1] == 0.0);
+	n = 1;
+	while (n <= SHADOW_MAX_SAMPLES)
+	{
+		set_shadow_samples(&config, n);
+		assert(config.samples == n);
+		assert(n < 4 || config.probes == (int)floor(sqrt(n)) + 1);
+		assert(n >= 4 || config.probes == 1);
+		assert(disk_within_radius(&config));
+		n++;
+	}
 	printf("✓ set_shadow_samples passed\n");
 }
 
 void	test_set_shadow_softness(void)
 {
 	t_shadow_config	config;
+	double			disk[SHADOW_MAX_SAMPLES][2];
 
 	printf("Testing set_shadow_softness...\n");
 	config = init_shadow_config();
+	memcpy(disk, config.disk, sizeof(disk));
 	set_shadow_softness(&config, 0.5);
 	assert(config.softness == 0.5);
+	assert(memcmp(disk, config.disk, sizeof(disk)) != 0);
+	assert(disk_within_radius(&config));
+	assert(fabs(config.disk[1][0] - disk[1][0] * 0.5 / 0.3) < 1e-9);
 	set_shadow_softness(&config, -0.1);
 	assert(config.softness == 0.5);
 	set_shadow_softness(&config, 1.1);